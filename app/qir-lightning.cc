@@ -7,12 +7,17 @@
 //---------------------------------------------------------------------------//
 #include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 #include <CLI/CLI.hpp>
 
+#include "qiree/CircuitAnalysis.hh"
 #include "qiree/Executor.hh"
 #include "qiree/Module.hh"
+#include "qiree/PermutedQuantum.hh"
 #include "qiree/ResultDistribution.hh"
+#include "qiree/ShotScheduler.hh"
 #include "qirlightning/LightningQuantum.hh"
 #include "qirlightning/LightningRuntime.hh"
 
@@ -23,24 +28,85 @@ namespace qiree
 namespace app
 {
 //---------------------------------------------------------------------------//
-void run(std::string const& filename, int num_shots)
+Module load(std::string const& filename,
+            std::vector<std::string> const& libraries)
 {
+    Module result{filename};
+    for (auto const& lib : libraries)
+    {
+        result.link(lib);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+void run(std::string const& filename,
+         std::vector<std::string> const& libraries,
+         ExecutorOptions const& exec_options,
+         int num_shots,
+         int num_threads,
+         bool compact_qubits,
+         bool permute_qubits)
+{
+    // Relabel qubits so that strongly interacting ones are close together
+    PermutedQuantum::VecIndex perm;
+    if (permute_qubits)
+    {
+        CircuitAnalysis analysis{load(filename, libraries)};
+        if (analysis.complete())
+        {
+            perm = locality_permutation(analysis);
+        }
+        else
+        {
+            std::clog << "Not permuting qubits: circuit analysis is "
+                         "incomplete"
+                      << std::endl;
+        }
+    }
+
     // Load the input
-    Executor execute{Module{filename}};
+    Executor execute{load(filename, libraries), exec_options};
 
-    // Set up qsim
-    LightningQuantum sim(std::cout, 0);
-    LightningRuntime rt(std::cout, sim);
-    ResultDistribution distribution;
+    // Set up one Lightning device per worker
+    ShotSchedulerOptions options;
+    options.num_workers = num_threads;
+    options.compact_qubits = compact_qubits;
+    options.prune_lightcone = exec_options.prune_lightcone;
+    ShotScheduler schedule(
+        execute,
+        [&perm](size_type worker, size_type num_workers) {
+            auto sim = std::make_shared<LightningQuantum>(
+                std::cout, ShotScheduler::worker_seed(worker, num_workers));
+            auto rt = std::make_shared<LightningRuntime>(std::cout, *sim);
+            if (perm.empty())
+            {
+                return ShotScheduler::Backend{std::move(sim), std::move(rt)};
+            }
+            // The runtime reads results directly from the simulator, which
+            // the permuted interface keeps alive
+            std::shared_ptr<QuantumInterface> permuted(
+                new PermutedQuantum{*sim, perm},
+                [sim](PermutedQuantum* p) { delete p; });
+            return ShotScheduler::Backend{std::move(permuted), std::move(rt)};
+        },
+        options);
 
     // Run several time = shots (default 1)
-    for (int i = 0; i < num_shots; i++)
-    {
-        execute(sim, rt);
-        distribution.accumulate(rt.result());
-    }
+    ResultDistribution distribution = schedule(num_shots);
 
     std::cout << distribution.to_json() << std::endl;
+
+    auto const& stats = schedule.stats();
+    std::clog << "Ran " << stats.num_shots << " shots on "
+              << stats.num_workers << " threads in " << stats.seconds
+              << " s (" << stats.shots_per_second() << " shots/s)"
+              << std::endl;
+    if (stats.gates_pruned > 0)
+    {
+        std::clog << "Pruned " << stats.gates_pruned
+                  << " operations from each replayed shot" << std::endl;
+    }
 }
 
 //---------------------------------------------------------------------------//
@@ -54,21 +120,77 @@ void run(std::string const& filename, int num_shots)
 int main(int argc, char* argv[])
 {
     int num_shots{1};
+    int num_threads{1};
     std::string filename;
+    std::vector<std::string> libraries;
+    std::string jit{qiree::to_cstring(qiree::ExecutorOptions{}.engine)};
+    std::string cache_dir;
+    int opt_level{0};
+    bool simplify_gates{false};
+    bool prune_lightcone{false};
+    bool buffer_gates{false};
+    bool compact_qubits{false};
+    bool permute_qubits{false};
 
     CLI::App app;
 
     auto* filename_opt
         = app.add_option("--input,-i,input", filename, "QIR input file");
     filename_opt->required();
+    app.add_option(
+        "-l,--library", libraries, "QIR library to link with the input");
 
     auto* nshot_opt
         = app.add_option("-s,--shots", num_shots, "Number of shots");
     nshot_opt->capture_default_str();
 
+    auto* nthread_opt = app.add_option(
+        "-t,--threads", num_threads, "Number of threads running shots");
+    nthread_opt->capture_default_str()->check(CLI::PositiveNumber);
+
+    auto* jit_opt = app.add_option("--jit", jit, "JIT compilation engine");
+    jit_opt->capture_default_str()->check(
+        CLI::IsMember({"mcjit", "orc", "orc-lazy"}));
+    app.add_option(
+        "--cache-dir", cache_dir, "Directory for reusing compiled objects");
+    auto* opt_opt = app.add_option(
+        "-O,--opt-level", opt_level, "IR optimization level before JIT");
+    opt_opt->capture_default_str()->check(CLI::Range(0, 3));
+    app.add_flag("--simplify-gates",
+                 simplify_gates,
+                 "Cancel and merge adjacent gates before JIT");
+    app.add_flag("--prune-lightcone",
+                 prune_lightcone,
+                 "Remove gates that cannot affect the recorded results");
+    app.add_flag("--buffer-gates",
+                 buffer_gates,
+                 "Send gates to the simulator in batches from compiled code");
+    auto* compact_opt
+        = app.add_flag("--compact-qubits",
+                       compact_qubits,
+                       "Reuse measured qubits when replaying shots");
+    app.add_flag("--permute-qubits",
+                 permute_qubits,
+                 "Relabel qubits for memory locality in the simulator")
+        ->excludes(compact_opt);
+
     CLI11_PARSE(app, argc, argv);
 
-    qiree::app::run(filename, num_shots);
+    qiree::ExecutorOptions exec_options;
+    exec_options.engine = qiree::to_jit_engine(jit);
+    exec_options.cache_dir = cache_dir;
+    exec_options.opt_level = static_cast<qiree::OptLevel>(opt_level);
+    exec_options.simplify_gates = simplify_gates;
+    exec_options.prune_lightcone = prune_lightcone;
+    exec_options.buffer_gates = buffer_gates;
+
+    qiree::app::run(filename,
+                    libraries,
+                    exec_options,
+                    num_shots,
+                    num_threads,
+                    compact_qubits,
+                    permute_qubits);
 
     return EXIT_SUCCESS;
 }
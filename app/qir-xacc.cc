@@ -9,6 +9,7 @@
 #include <iostream>
 #include <string>
 #include <string_view>
+#include <vector>
 #include <CLI/CLI.hpp>
 
 #include "qiree_version.h"
@@ -26,15 +27,29 @@ namespace qiree
 {
 namespace app
 {
+//---------------------------------------------------------------------------//
+Module load(std::string const& filename,
+            std::vector<std::string> const& libraries)
+{
+    Module result{filename};
+    for (auto const& lib : libraries)
+    {
+        result.link(lib);
+    }
+    return result;
+}
+
 //---------------------------------------------------------------------------//
 void run(std::string const& filename,
+         std::vector<std::string> const& libraries,
+         ExecutorOptions const& exec_options,
          std::string const& accel_name,
          int num_shots,
          bool print_accelbuf,
          bool group_tuples)
 {
     // Load the input
-    Executor execute{Module{filename}};
+    Executor execute{load(filename, libraries), exec_options};
 
     // Set up XACC
     XaccQuantum xacc(std::cout, accel_name, num_shots);
@@ -67,13 +82,19 @@ int main(int argc, char* argv[])
     int num_shots{1024};
     std::string accel_name;
     std::string filename;
+    std::vector<std::string> libraries;
     bool no_print_accelbuf{false};
     bool group_tuples{false};
+    std::string jit{qiree::to_cstring(qiree::ExecutorOptions{}.engine)};
+    std::string cache_dir;
+    int opt_level{0};
 
     CLI::App app;
     auto* filename_opt
         = app.add_option("--input,-i,input", filename, "QIR input file");
     filename_opt->required();
+    app.add_option(
+        "-l,--library", libraries, "QIR library to link with the input");
     auto* accel_opt
         = app.add_option("-a,--accelerator", accel_name, "Accelerator name");
     accel_opt->required();
@@ -87,11 +108,29 @@ int main(int argc, char* argv[])
                  group_tuples,
                  "Print per-tuple/per-array measurement statistics rather "
                  "than per-qubit");
+    auto* jit_opt = app.add_option("--jit", jit, "JIT compilation engine");
+    jit_opt->capture_default_str()->check(
+        CLI::IsMember({"mcjit", "orc", "orc-lazy"}));
+    app.add_option(
+        "--cache-dir", cache_dir, "Directory for reusing compiled objects");
+    auto* opt_opt = app.add_option(
+        "-O,--opt-level", opt_level, "IR optimization level before JIT");
+    opt_opt->capture_default_str()->check(CLI::Range(0, 3));
 
     CLI11_PARSE(app, argc, argv);
 
-    qiree::app::run(
-        filename, accel_name, num_shots, !no_print_accelbuf, group_tuples);
+    qiree::ExecutorOptions exec_options;
+    exec_options.engine = qiree::to_jit_engine(jit);
+    exec_options.cache_dir = cache_dir;
+    exec_options.opt_level = static_cast<qiree::OptLevel>(opt_level);
+
+    qiree::app::run(filename,
+                    libraries,
+                    exec_options,
+                    accel_name,
+                    num_shots,
+                    !no_print_accelbuf,
+                    group_tuples);
 
     return EXIT_SUCCESS;
 }
@@ -121,7 +121,7 @@ class QisGenerator(Generator):
 
         binding_decl.append(")")
         binding_call = "".join(
-            ["q_interface_->", cppname, "("] +
+            ["quantum().", cppname, "("] +
             [", ".join(binding_args)] +
             [")"]
         )
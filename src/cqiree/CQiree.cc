@@ -72,6 +72,35 @@ QireeReturnCode qiree_num_classical_reg(CQiree* manager, int* result)
         cpp_manager->num_classical_reg(*result));
 }
 
+QireeReturnCode qiree_set_num_threads(CQiree* manager, int num_threads)
+{
+    if (!manager)
+        return QIREE_NOT_READY;
+
+    auto* cpp_manager = reinterpret_cast<QM*>(manager);
+    return static_cast<QireeReturnCode>(
+        cpp_manager->set_num_threads(num_threads));
+}
+
+QireeReturnCode qiree_set_cache_dir(CQiree* manager, char const* directory)
+{
+    if (!manager)
+        return QIREE_NOT_READY;
+
+    auto* cpp_manager = reinterpret_cast<QM*>(manager);
+    return static_cast<QireeReturnCode>(
+        cpp_manager->set_cache_dir(directory ? directory : ""));
+}
+
+QireeReturnCode qiree_set_opt_level(CQiree* manager, int opt_level)
+{
+    if (!manager)
+        return QIREE_NOT_READY;
+
+    auto* cpp_manager = reinterpret_cast<QM*>(manager);
+    return static_cast<QireeReturnCode>(cpp_manager->set_opt_level(opt_level));
+}
+
 QireeReturnCode
 qiree_max_result_items(CQiree* manager, int num_shots, size_t* result)
 {
@@ -38,7 +38,9 @@ typedef struct
 /* Create a QireeManager instance */
 CQiree* qiree_create();
 
-/* Module loading functions */
+/* Module loading functions: bitcode and null-terminated text (with the null
+ * included in the length) are parsed without copying the data, and bitcode
+ * files are loaded lazily so that queries do not read function bodies */
 QireeReturnCode qiree_load_module_from_memory(CQiree* manager,
                                               char const* data_contents,
                                               size_t length);
@@ -49,6 +51,17 @@ qiree_load_module_from_file(CQiree* manager, char const* filename);
 QireeReturnCode qiree_num_quantum_reg(CQiree* manager, int* result);
 QireeReturnCode qiree_num_classical_reg(CQiree* manager, int* result);
 
+/* Number of threads running shots (zero for all available): call before
+ * setting up the executor */
+QireeReturnCode qiree_set_num_threads(CQiree* manager, int num_threads);
+
+/* Directory for caching compiled objects (null to disable): call before
+ * setting up the executor */
+QireeReturnCode qiree_set_cache_dir(CQiree* manager, char const* directory);
+
+/* IR optimization level from 0 to 3: call before setting up the executor */
+QireeReturnCode qiree_set_opt_level(CQiree* manager, int opt_level);
+
 /* Number of records needed to store result, including capacity */
 QireeReturnCode
 qiree_max_result_items(CQiree* manager, int num_shots, size_t* result);
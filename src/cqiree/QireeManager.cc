@@ -7,9 +7,12 @@
 //---------------------------------------------------------------------------//
 #include "QireeManager.hh"
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 
 #include "qiree_config.h"
 
@@ -18,6 +21,7 @@
 #include "qiree/Module.hh"
 #include "qiree/QuantumInterface.hh"
 #include "qiree/ResultDistribution.hh"
+#include "qiree/ShotScheduler.hh"
 #include "qiree/SingleResultRuntime.hh"
 #include "qirqsim/QsimQuantum.hh"
 #include "qirqsim/QsimRuntime.hh"
@@ -41,9 +45,7 @@ QireeManager::load_module(std::string_view data_contents) throw()
 {
     try
     {
-        // Convert string_view to string for Module constructor
-        std::string content{data_contents};
-        module_ = Module::from_bytes(content);
+        module_ = Module::from_bytes(data_contents);
     }
     catch (std::exception const& e)
     {
@@ -105,6 +107,54 @@ QireeManager::ReturnCode QireeManager::num_classical_reg(int& result) const
     return ReturnCode::success;
 }
 
+//---------------------------------------------------------------------------//
+QireeManager::ReturnCode QireeManager::set_num_threads(int num_threads) throw()
+{
+    if (execute_)
+    {
+        CQIREE_FAIL(not_ready,
+                    "cannot set number of threads after creating executor");
+    }
+    if (num_threads < 0)
+    {
+        CQIREE_FAIL(invalid_input, "num_threads was negative");
+    }
+
+    num_threads_ = num_threads;
+    return ReturnCode::success;
+}
+
+//---------------------------------------------------------------------------//
+QireeManager::ReturnCode
+QireeManager::set_cache_dir(std::string directory) throw()
+{
+    if (execute_)
+    {
+        CQIREE_FAIL(not_ready,
+                    "cannot set cache directory after creating executor");
+    }
+
+    cache_dir_ = std::move(directory);
+    return ReturnCode::success;
+}
+
+//---------------------------------------------------------------------------//
+QireeManager::ReturnCode QireeManager::set_opt_level(int opt_level) throw()
+{
+    if (execute_)
+    {
+        CQIREE_FAIL(not_ready,
+                    "cannot set optimization level after creating executor");
+    }
+    if (opt_level < 0 || opt_level > 3)
+    {
+        CQIREE_FAIL(invalid_input, "opt_level must be between 0 and 3");
+    }
+
+    opt_level_ = opt_level;
+    return ReturnCode::success;
+}
+
 //---------------------------------------------------------------------------//
 QireeManager::ReturnCode
 QireeManager::max_result_items(int num_shots, std::size_t& result) const
@@ -146,6 +196,7 @@ QireeManager::setup_executor(std::string_view backend,
         CQIREE_FAIL(not_ready, "cannot create executor again");
     }
 
+    ShotScheduler::BackendFactory make_backend;
     try
     {
         if (!config_json.empty())
@@ -156,13 +207,21 @@ QireeManager::setup_executor(std::string_view backend,
         if (backend == "qsim")
         {
 #if QIREE_USE_QSIM
-            // Create runtime interface: give runtime a pointer to quantum
-            // (lifetime of the reference is guaranteed by our shared pointer
-            // copy)
-            constexpr unsigned long int seed = 0;
-            auto quantum = std::make_shared<QsimQuantum>(std::cout, seed);
-            runtime_ = std::make_shared<QsimRuntime>(std::cout, *quantum);
-            quantum_ = std::move(quantum);
+            // Create quantum and runtime interfaces for each worker: give
+            // runtime a pointer to quantum (lifetime of the reference is
+            // guaranteed by our shared pointer copy)
+            make_backend = [](size_type worker, size_type num_workers) {
+                unsigned int const sim_threads = std::max<unsigned int>(
+                    1, std::thread::hardware_concurrency() / num_workers);
+                auto quantum = std::make_shared<QsimQuantum>(
+                    std::cout,
+                    ShotScheduler::worker_seed(worker, num_workers),
+                    sim_threads);
+                auto runtime
+                    = std::make_shared<QsimRuntime>(std::cout, *quantum);
+                return ShotScheduler::Backend{std::move(quantum),
+                                              std::move(runtime)};
+            };
 #else
             QIREE_NOT_CONFIGURED("QSim");
 #endif
@@ -191,7 +250,16 @@ QireeManager::setup_executor(std::string_view backend,
     {
         // Create executor with the module, quantum and runtime interfaces
         QIREE_ASSERT(module_ && *module_);
-        execute_ = std::make_unique<Executor>(std::move(*module_));
+        ExecutorOptions exec_options;
+        exec_options.cache_dir = cache_dir_;
+        exec_options.opt_level = static_cast<OptLevel>(opt_level_);
+        execute_
+            = std::make_unique<Executor>(std::move(*module_), exec_options);
+
+        ShotSchedulerOptions options;
+        options.num_workers = num_threads_;
+        schedule_ = std::make_unique<ShotScheduler>(
+            *execute_, make_backend, options);
     }
     catch (std::exception const& e)
     {
@@ -204,7 +272,7 @@ QireeManager::setup_executor(std::string_view backend,
 //---------------------------------------------------------------------------//
 QireeManager::ReturnCode QireeManager::execute(int num_shots) throw()
 {
-    if (!execute_)
+    if (!schedule_)
     {
         CQIREE_FAIL(not_ready, "setup_executor was not created");
     }
@@ -216,14 +284,8 @@ QireeManager::ReturnCode QireeManager::execute(int num_shots) throw()
 
     try
     {
-        QIREE_ASSERT(runtime_ && quantum_);
-        result_ = std::make_unique<ResultDistribution>();
-
-        for (auto i = 0; i < num_shots; ++i)
-        {
-            (*execute_)(*quantum_, *runtime_);
-            result_->accumulate(runtime_->result());
-        }
+        result_ = std::make_unique<ResultDistribution>(
+            (*schedule_)(num_shots));
     }
     catch (std::exception const& e)
     {
@@ -18,9 +18,8 @@ namespace qiree
 {
 class Executor;
 class Module;
-class QuantumInterface;
-class SingleResultRuntime;
 class ResultDistribution;
+class ShotScheduler;
 
 //---------------------------------------------------------------------------//
 /*!
@@ -54,6 +53,9 @@ class QireeManager
     ReturnCode load_module(std::string filename) throw();
     ReturnCode num_quantum_reg(int& result) const throw();
     ReturnCode num_classical_reg(int& result) const throw();
+    ReturnCode set_num_threads(int num_threads) throw();
+    ReturnCode set_cache_dir(std::string directory) throw();
+    ReturnCode set_opt_level(int opt_level) throw();
     ReturnCode setup_executor(std::string_view backend,
                               std::string_view config_json = {}) throw();
 
@@ -68,9 +70,11 @@ class QireeManager
   private:
     std::unique_ptr<Module> module_;
     std::unique_ptr<Executor> execute_;
-    std::shared_ptr<QuantumInterface> quantum_;
-    std::shared_ptr<SingleResultRuntime> runtime_;
+    std::unique_ptr<ShotScheduler> schedule_;
     std::unique_ptr<ResultDistribution> result_;
+    int num_threads_{1};
+    std::string cache_dir_;
+    int opt_level_{0};
 };
 
 }  // namespace qiree
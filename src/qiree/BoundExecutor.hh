@@ -0,0 +1,141 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/BoundExecutor.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <type_traits>
+
+#include "Assert.hh"
+#include "Executor.hh"
+#include "Macros.hh"
+#include "QuantumInterface.hh"
+#include "RuntimeInterface.hh"
+#include "detail/BoundFunctions.hh"
+#include "detail/EndGuard.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Executor whose QIR calls go directly to a concrete backend.
+ *
+ * The base \c Executor binds each QIR function to a wrapper that calls
+ * through the virtual \c QuantumInterface . This class instead binds the
+ * common gate, measurement, and output functions to trampolines that call
+ * the members of \c Q and \c R directly, removing the vtable lookup from
+ * every gate. Functions without a trampoline use the virtual path.
+ *
+ * \code
+   BoundExecutor<QsimQuantum, QsimRuntime> execute{std::move(module)};
+   execute(sim, rt);
+ * \endcode
+ */
+template<class Q, class R = RuntimeInterface>
+class BoundExecutor
+{
+    static_assert(std::is_base_of_v<QuantumInterface, Q>,
+                  "not a quantum interface");
+    static_assert(std::is_base_of_v<RuntimeInterface, R>,
+                  "not a runtime interface");
+
+  public:
+    // Construct with a QIR module and compilation options
+    explicit inline BoundExecutor(Module&& module,
+                                  ExecutorOptions const& options = {});
+
+    // Execute with the given backend
+    inline void operator()(Q& qi, R& ri) const;
+
+    // Execute many shots in a compiled loop
+    inline void run_shots(Q& qi,
+                          R& ri,
+                          size_type num_shots,
+                          Executor::ShotCallback const& on_shot) const;
+
+    //! Whether every execution makes the same sequence of QIR calls
+    bool shot_invariant() const { return execute_.shot_invariant(); }
+
+    //! Whether measurement outcomes affect the circuit
+    ExecutionClass execution_class() const
+    {
+        return execute_.execution_class();
+    }
+
+    //! Get compilation statistics
+    ExecutorStats stats() const { return execute_.stats(); }
+
+  private:
+    using Functions = detail::BoundFunctions<Q, R>;
+
+    Executor execute_;
+
+    template<class F>
+    inline void bind(Q& qi, R& ri, F&& execute) const;
+};
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with a QIR module and compilation options.
+ */
+template<class Q, class R>
+BoundExecutor<Q, R>::BoundExecutor(Module&& module,
+                                   ExecutorOptions const& options)
+    : execute_{std::move(module), options, Functions::overrides()}
+{
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Execute with the given backend.
+ *
+ * As with \c Executor , the backend is bound to the calling thread for the
+ * duration of the call.
+ */
+template<class Q, class R>
+void BoundExecutor<Q, R>::operator()(Q& qi, R& ri) const
+{
+    this->bind(qi, ri, [&] { execute_(qi, ri); });
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Execute many shots in a compiled loop.
+ */
+template<class Q, class R>
+void BoundExecutor<Q, R>::run_shots(Q& qi,
+                                    R& ri,
+                                    size_type num_shots,
+                                    Executor::ShotCallback const& on_shot) const
+{
+    this->bind(
+        qi, ri, [&] { execute_.run_shots(qi, ri, num_shots, on_shot); });
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Bind the backend to the trampolines while executing.
+ */
+template<class Q, class R>
+template<class F>
+void BoundExecutor<Q, R>::bind(Q& qi, R& ri, F&& execute) const
+{
+    QIREE_VALIDATE(!Functions::quantum && !Functions::runtime,
+                   << "cannot call LLVM executor recursively");
+    detail::EndGuard on_end_scope_([] {
+        Functions::quantum = nullptr;
+        Functions::runtime = nullptr;
+    });
+    Functions::quantum = &qi;
+    Functions::runtime = &ri;
+
+    execute();
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
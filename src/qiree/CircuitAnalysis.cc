@@ -0,0 +1,559 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/CircuitAnalysis.cc
+//---------------------------------------------------------------------------//
+#include "CircuitAnalysis.hh"
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <llvm/ADT/APInt.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+
+#include "Assert.hh"
+#include "Module.hh"
+#include "QubitPool.hh"
+#include "detail/Materialize.hh"
+#include "detail/MeasurementFlow.hh"
+
+namespace qiree
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+constexpr llvm::StringLiteral qis_prefix{"__quantum__qis__"};
+constexpr llvm::StringLiteral read_result_name{
+    "__quantum__qis__read_result__body"};
+constexpr llvm::StringLiteral qubit_allocate_name{
+    "__quantum__rt__qubit_allocate"};
+constexpr llvm::StringLiteral qubit_release_name{
+    "__quantum__rt__qubit_release"};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Whether a string starts with a prefix (portable across LLVM versions).
+ */
+bool starts_with(llvm::StringRef s, llvm::StringRef prefix)
+{
+    return s.substr(0, prefix.size()) == prefix;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the operation name and qubit arguments of a QIS function.
+ *
+ * The name matches \c GateOpCode : the \c __body suffix is dropped and other
+ * suffixes are joined with an underscore. Qubit arguments are returned as
+ * operand indices, and are empty for operations taking arrays.
+ */
+std::string
+qis_operation(llvm::Function const& f, std::vector<unsigned>* qubit_args)
+{
+    llvm::StringRef name = f.getName().drop_front(qis_prefix.size());
+    auto [gate, suffix] = name.rsplit("__");
+
+    qubit_args->clear();
+    if (gate == "mz")
+    {
+        qubit_args->push_back(0);
+    }
+    else if (gate == "r")
+    {
+        qubit_args->push_back(2);
+    }
+    else if (!starts_with(suffix, "ctl") && gate != "exp"
+             && gate != "assertmeasurementprobability")
+    {
+        // All pointer arguments are qubits
+        for (llvm::Argument const& arg : f.args())
+        {
+            if (arg.getType()->isPointerTy())
+            {
+                qubit_args->push_back(arg.getArgNo());
+            }
+        }
+    }
+
+    std::string result = gate.str();
+    if (suffix != "body")
+    {
+        result += '_';
+        result += suffix.str();
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Symbolically execute a function with integer arguments.
+ *
+ * Each SSA value is either a known integer (pointers are treated as 64-bit
+ * integers) or unknown. Scalar stack variables are tracked so that loops
+ * written with \c alloca , as emitted by unoptimized frontends, are followed.
+ * Execution fails when the control flow or a qubit argument is unknown.
+ */
+class Interpreter
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using SymValue = std::optional<llvm::APInt>;
+    using VecQubit = std::vector<size_type>;
+    using OpVisitor = std::function<void(std::string const&, VecQubit const&)>;
+    //!@}
+
+  public:
+    // Construct with a function to call for each quantum operation
+    explicit Interpreter(OpVisitor visit) : visit_{std::move(visit)} {}
+
+    //! Run a function, returning false if the analysis stopped early
+    bool operator()(llvm::Function& f)
+    {
+        SymValue unused;
+        return this->call(f, {}, 0, &unused);
+    }
+
+  private:
+    using ValueMap = std::unordered_map<llvm::Value const*, SymValue>;
+
+    static constexpr size_type max_steps_{size_type(1) << 26};
+    static constexpr int max_depth_{256};
+
+    OpVisitor visit_;
+    QubitPool pool_;
+    size_type steps_{0};
+    VecQubit qubits_;
+    std::vector<unsigned> qubit_args_;
+
+    bool call(llvm::Function& f,
+              std::vector<SymValue> args,
+              int depth,
+              SymValue* result);
+    bool execute(llvm::Instruction& inst,
+                 ValueMap& values,
+                 ValueMap& memory,
+                 int depth);
+    bool call_qis(llvm::CallBase& call, ValueMap& values);
+    SymValue eval(llvm::Value const* v, ValueMap const& values) const;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the bit width of an integer or pointer type, or zero.
+ */
+unsigned bit_width(llvm::Type const* t)
+{
+    if (t->isPointerTy())
+        return 64;
+    if (t->isIntegerTy())
+        return t->getIntegerBitWidth();
+    return 0;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Convert a value to a new bit width.
+ */
+Interpreter::SymValue cast(Interpreter::SymValue const& v,
+                           unsigned opcode,
+                           llvm::Type const* dest)
+{
+    unsigned width = bit_width(dest);
+    if (!v || !width)
+        return {};
+    if (opcode == llvm::Instruction::SExt)
+        return v->sextOrTrunc(width);
+    return v->zextOrTrunc(width);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Apply an integer binary operator.
+ */
+Interpreter::SymValue
+binary_op(unsigned opcode, llvm::APInt const& a, llvm::APInt const& b)
+{
+    using I = llvm::Instruction;
+    bool const zero = b.isZero();
+    switch (opcode)
+    {
+        // clang-format off
+        case I::Add: return a + b;
+        case I::Sub: return a - b;
+        case I::Mul: return a * b;
+        case I::And: return a & b;
+        case I::Or: return a | b;
+        case I::Xor: return a ^ b;
+        case I::Shl: return a.shl(b);
+        case I::LShr: return a.lshr(b);
+        case I::AShr: return a.ashr(b);
+        case I::UDiv: if (!zero) return a.udiv(b); break;
+        case I::SDiv: if (!zero) return a.sdiv(b); break;
+        case I::URem: if (!zero) return a.urem(b); break;
+        case I::SRem: if (!zero) return a.srem(b); break;
+        // clang-format on
+        default:
+            break;
+    }
+    return {};
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Execute a function, saving its return value.
+ */
+bool Interpreter::call(llvm::Function& f,
+                       std::vector<SymValue> args,
+                       int depth,
+                       SymValue* result)
+{
+    if (depth > max_depth_ || f.isDeclaration())
+    {
+        return false;
+    }
+
+    ValueMap values;
+    ValueMap memory;
+    for (llvm::Argument& arg : f.args())
+    {
+        if (arg.getArgNo() < args.size())
+        {
+            values[&arg] = std::move(args[arg.getArgNo()]);
+        }
+    }
+
+    llvm::BasicBlock* prev = nullptr;
+    llvm::BasicBlock* block = &f.getEntryBlock();
+    std::vector<std::pair<llvm::PHINode*, SymValue>> phis;
+    while (true)
+    {
+        // Evaluate all phi nodes before assigning any of them
+        phis.clear();
+        for (llvm::PHINode& phi : block->phis())
+        {
+            int idx = prev ? phi.getBasicBlockIndex(prev) : -1;
+            phis.emplace_back(
+                &phi,
+                idx < 0 ? SymValue{}
+                        : this->eval(phi.getIncomingValue(idx), values));
+        }
+        for (auto& [phi, value] : phis)
+        {
+            values[phi] = std::move(value);
+        }
+
+        // Execute the block body
+        for (llvm::Instruction& inst : block->instructionsWithoutDebug())
+        {
+            if (llvm::isa<llvm::PHINode>(inst) || inst.isTerminator())
+            {
+                continue;
+            }
+            if (++steps_ > max_steps_
+                || !this->execute(inst, values, memory, depth))
+            {
+                return false;
+            }
+        }
+
+        // Follow the terminator
+        llvm::Instruction* term = block->getTerminator();
+        llvm::BasicBlock* next = nullptr;
+        if (auto* ret = llvm::dyn_cast<llvm::ReturnInst>(term))
+        {
+            if (llvm::Value const* v = ret->getReturnValue())
+            {
+                *result = this->eval(v, values);
+            }
+            return true;
+        }
+        else if (auto* br = llvm::dyn_cast<llvm::BranchInst>(term))
+        {
+            if (br->isUnconditional())
+            {
+                next = br->getSuccessor(0);
+            }
+            else if (auto cond = this->eval(br->getCondition(), values))
+            {
+                next = br->getSuccessor(cond->isOne() ? 0 : 1);
+            }
+        }
+        else if (auto* sw = llvm::dyn_cast<llvm::SwitchInst>(term))
+        {
+            if (auto cond = this->eval(sw->getCondition(), values))
+            {
+                next = sw->getDefaultDest();
+                for (auto const& c : sw->cases())
+                {
+                    if (c.getCaseValue()->getValue() == *cond)
+                    {
+                        next = c.getCaseSuccessor();
+                        break;
+                    }
+                }
+            }
+        }
+        if (!next)
+        {
+            return false;
+        }
+        prev = block;
+        block = next;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Execute a non-terminator instruction.
+ */
+bool Interpreter::execute(llvm::Instruction& inst,
+                          ValueMap& values,
+                          ValueMap& memory,
+                          int depth)
+{
+    SymValue result;
+    if (auto* bo = llvm::dyn_cast<llvm::BinaryOperator>(&inst))
+    {
+        auto a = this->eval(bo->getOperand(0), values);
+        auto b = this->eval(bo->getOperand(1), values);
+        if (a && b)
+        {
+            result = binary_op(bo->getOpcode(), *a, *b);
+        }
+    }
+    else if (auto* cmp = llvm::dyn_cast<llvm::ICmpInst>(&inst))
+    {
+        auto a = this->eval(cmp->getOperand(0), values);
+        auto b = this->eval(cmp->getOperand(1), values);
+        if (a && b)
+        {
+            result = llvm::APInt(
+                1, llvm::ICmpInst::compare(*a, *b, cmp->getPredicate()));
+        }
+    }
+    else if (auto* ci = llvm::dyn_cast<llvm::CastInst>(&inst))
+    {
+        result = cast(this->eval(ci->getOperand(0), values),
+                      ci->getOpcode(),
+                      ci->getType());
+    }
+    else if (auto* sel = llvm::dyn_cast<llvm::SelectInst>(&inst))
+    {
+        if (auto cond = this->eval(sel->getCondition(), values))
+        {
+            result = this->eval(
+                cond->isOne() ? sel->getTrueValue() : sel->getFalseValue(),
+                values);
+        }
+    }
+    else if (auto* store = llvm::dyn_cast<llvm::StoreInst>(&inst))
+    {
+        // Track scalar stack variables
+        llvm::Value const* ptr = store->getPointerOperand();
+        if (llvm::isa<llvm::AllocaInst>(ptr))
+        {
+            memory[ptr] = this->eval(store->getValueOperand(), values);
+        }
+        return true;
+    }
+    else if (auto* load = llvm::dyn_cast<llvm::LoadInst>(&inst))
+    {
+        auto iter = memory.find(load->getPointerOperand());
+        if (iter != memory.end())
+        {
+            result = cast(
+                iter->second, llvm::Instruction::ZExt, load->getType());
+        }
+    }
+    else if (auto* call = llvm::dyn_cast<llvm::CallBase>(&inst))
+    {
+        llvm::Function* f = call->getCalledFunction();
+        if (!f)
+        {
+            // Indirect call
+            return false;
+        }
+        if (starts_with(f->getName(), qis_prefix))
+        {
+            if (f->getName() != read_result_name
+                && !this->call_qis(*call, values))
+            {
+                return false;
+            }
+        }
+        else if (f->getName() == qubit_allocate_name)
+        {
+            // Assign indices exactly as the executor does
+            result = llvm::APInt(64, pool_.allocate().value);
+        }
+        else if (f->getName() == qubit_release_name)
+        {
+            auto q = call->arg_size() == 1
+                         ? this->eval(call->getArgOperand(0), values)
+                         : std::nullopt;
+            if (!q)
+            {
+                return false;
+            }
+            pool_.release(Qubit{q->getLimitedValue()});
+        }
+        else if (!f->isDeclaration())
+        {
+            std::vector<SymValue> args;
+            for (llvm::Value const* arg : call->args())
+            {
+                args.push_back(this->eval(arg, values));
+            }
+            if (!this->call(*f, std::move(args), depth + 1, &result))
+            {
+                return false;
+            }
+        }
+    }
+    else if (llvm::isa<llvm::AllocaInst>(&inst))
+    {
+        // Stack variable is uninitialized
+        memory.erase(&inst);
+    }
+
+    values[&inst] = std::move(result);
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Pass a quantum operation to the visitor.
+ */
+bool Interpreter::call_qis(llvm::CallBase& call, ValueMap& values)
+{
+    std::string name = qis_operation(*call.getCalledFunction(), &qubit_args_);
+
+    qubits_.clear();
+    for (unsigned i : qubit_args_)
+    {
+        if (i >= call.arg_size())
+        {
+            return false;
+        }
+        auto q = this->eval(call.getArgOperand(i), values);
+        if (!q)
+        {
+            // Qubit computed from an unknown value
+            return false;
+        }
+        qubits_.push_back(q->getLimitedValue());
+    }
+    visit_(name, qubits_);
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Evaluate an operand.
+ */
+auto Interpreter::eval(llvm::Value const* v, ValueMap const& values) const
+    -> SymValue
+{
+    if (auto* ci = llvm::dyn_cast<llvm::ConstantInt>(v))
+    {
+        return ci->getValue();
+    }
+    if (llvm::isa<llvm::ConstantPointerNull>(v))
+    {
+        return llvm::APInt(64, 0);
+    }
+    if (auto* ce = llvm::dyn_cast<llvm::ConstantExpr>(v))
+    {
+        if (ce->isCast())
+        {
+            return cast(this->eval(ce->getOperand(0), values),
+                        ce->getOpcode(),
+                        ce->getType());
+        }
+        return {};
+    }
+    auto iter = values.find(v);
+    if (iter != values.end())
+    {
+        return iter->second;
+    }
+    return {};
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Analyze the entry point of a module.
+ *
+ * Function bodies of lazily loaded bitcode are read as they are reached.
+ */
+CircuitAnalysis::CircuitAnalysis(Module const& module)
+{
+    QIREE_EXPECT(module);
+
+    std::optional<llvm::orc::ThreadSafeContext::Lock> context_lock;
+    if (module.context_)
+    {
+        context_lock.emplace(module.context_->getLock());
+    }
+    detail::load_reachable(*module.entrypoint_);
+
+    // Assign each operation to the layer after the last one on its qubits
+    std::unordered_map<size_type, size_type> qubit_depth;
+    auto add_operation = [&](std::string const& name,
+                             std::vector<size_type> const& qubits) {
+        ++gate_counts_[name];
+        ++num_gates_;
+        if (qubits.empty())
+        {
+            return;
+        }
+
+        size_type layer = 0;
+        for (size_type q : qubits)
+        {
+            layer = std::max(layer, qubit_depth[q]);
+            num_qubits_ = std::max(num_qubits_, q + 1);
+        }
+        ++layer;
+        for (size_type q : qubits)
+        {
+            qubit_depth[q] = layer;
+        }
+        depth_ = std::max(depth_, layer);
+
+        if (qubits.size() == 2 && qubits[0] != qubits[1])
+        {
+            ++num_two_qubit_gates_;
+        }
+        for (std::size_t i = 0; i < qubits.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < qubits.size(); ++j)
+            {
+                if (qubits[i] != qubits[j])
+                {
+                    ++interactions_[std::minmax(qubits[i], qubits[j])];
+                }
+            }
+        }
+    };
+
+    Interpreter interpret{add_operation};
+    complete_ = interpret(*module.entrypoint_);
+    measurement_feedback_
+        = detail::find_measurement_uses(*module.entrypoint_).branch;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
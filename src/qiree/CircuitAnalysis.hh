@@ -0,0 +1,98 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/CircuitAnalysis.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "Types.hh"
+
+namespace qiree
+{
+class Module;
+
+//---------------------------------------------------------------------------//
+/*!
+ * Static summary of the quantum circuit described by a QIR module.
+ *
+ * The analysis symbolically executes the entry point, following calls into
+ * functions defined in the module and evaluating integer arithmetic, phi
+ * nodes, and branches with constant conditions. Straight-line code and loops
+ * with a constant trip count are thus analyzed exactly without running any
+ * quantum operation or compiling the module. Dynamically allocated qubits
+ * are assigned the same indices as at run time (see \c QubitPool ), so
+ * \c num_qubits is then the peak number of live qubits.
+ *
+ * The analysis stops (and \c complete is false) at a branch whose condition
+ * is unknown, such as one that depends on a measurement, or at an operation
+ * whose qubit is not a constant. The counts then describe the operations
+ * executed up to that point.
+ *
+ * Operations are keyed by the QIS function name without the
+ * \c __quantum__qis__ prefix, using the same names as \c GateOpCode: e.g.,
+ * \c h , \c s_adj , \c x_ctl , \c mz . Controlled operations whose controls
+ * are passed in an array are counted but do not contribute to the depth or
+ * interaction graph.
+ *
+ * \code
+   CircuitAnalysis analysis{module};
+   if (analysis.complete() && analysis.num_qubits() <= 32) { ... }
+ * \endcode
+ */
+class CircuitAnalysis
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using MapStrCount = std::map<std::string, size_type>;
+    using QubitPair = std::pair<size_type, size_type>;
+    using MapPairCount = std::map<QubitPair, size_type>;
+    //!@}
+
+  public:
+    // Analyze the entry point of a module
+    explicit CircuitAnalysis(Module const& module);
+
+    //! Number of calls to each quantum operation
+    MapStrCount const& gate_counts() const { return gate_counts_; }
+
+    //! Total number of quantum operations
+    size_type num_gates() const { return num_gates_; }
+
+    //! Number of operations acting on exactly two qubits
+    size_type num_two_qubit_gates() const { return num_two_qubit_gates_; }
+
+    //! Number of layers when operations on disjoint qubits run in parallel
+    size_type depth() const { return depth_; }
+
+    //! One more than the largest qubit index used by an operation
+    size_type num_qubits() const { return num_qubits_; }
+
+    //! Number of multi-qubit operations for each pair of qubits (low, high)
+    MapPairCount const& interactions() const { return interactions_; }
+
+    //! Whether a measurement outcome can affect the control flow
+    bool measurement_feedback() const { return measurement_feedback_; }
+
+    //! Whether every operation in the program was analyzed
+    bool complete() const { return complete_; }
+
+  private:
+    MapStrCount gate_counts_;
+    size_type num_gates_{0};
+    size_type num_two_qubit_gates_{0};
+    size_type depth_{0};
+    size_type num_qubits_{0};
+    MapPairCount interactions_;
+    bool measurement_feedback_{false};
+    bool complete_{true};
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
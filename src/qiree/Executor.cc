@@ -7,20 +7,41 @@
 //---------------------------------------------------------------------------//
 #include "Executor.hh"
 
+#include <algorithm>
 #include <iostream>
+#include <optional>
+#include <string_view>
+#include <unordered_set>
+#include <llvm/Config/llvm-config.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
-#include <llvm/ExecutionEngine/GenericValue.h>
+#include <llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Module.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/TargetSelect.h>
 
 #include "Assert.hh"
+#include "CircuitAnalysis.hh"
+#include "GateTape.hh"
 #include "Module.hh"
 #include "QuantumInterface.hh"
+#include "QubitPool.hh"
+#include "RecordingQuantum.hh"
+#include "RecordingRuntime.hh"
 #include "RuntimeInterface.hh"
+#include "detail/CallBound.hh"
+#include "detail/DiskObjectCache.hh"
 #include "detail/EndGuard.hh"
+#include "detail/GateBuffer.hh"
 #include "detail/GlobalMapper.hh"
+#include "detail/Materialize.hh"
+#include "detail/Optimizer.hh"
+#include "detail/ResultHandle.hh"
+#include "detail/ShotLoop.hh"
+#include "detail/SymbolMapper.hh"
 
 namespace qiree
 {
@@ -28,13 +49,144 @@ namespace
 {
 //---------------------------------------------------------------------------//
 /*!
- * Pointer to active interfaces.
+ * Pointer to active interfaces for the current thread.
  *
- * LLVM's addGlobalMapping requires a global function symbol rather than a
- * std::function.
+ * The JIT engines bind QIR symbols to global functions rather than a
+ * std::function. Each thread that invokes an executor gets its own pair of
+ * pointers, so a single compiled module can be run concurrently against
+ * independent quantum and runtime interfaces.
  */
-static QuantumInterface* q_interface_{nullptr};
-static RuntimeInterface* r_interface_{nullptr};
+thread_local QuantumInterface* q_interface_{nullptr};
+thread_local RuntimeInterface* r_interface_{nullptr};
+
+//---------------------------------------------------------------------------//
+/*!
+ * State of a compiled shot loop running on the current thread.
+ */
+struct ShotLoopState
+{
+    EntryPointAttrs const* attrs{nullptr};
+    Executor::ShotCallback const* on_shot{nullptr};
+    bool in_shot{false};
+};
+
+thread_local ShotLoopState* shot_loop_{nullptr};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Dynamically managed qubits and results for an execution.
+ *
+ * Allocated indices are checked against the number of qubits and results the
+ * quantum interface was set up with. Results returned by measurements are
+ * numbered after the entry point's static results and reused every shot.
+ */
+struct DynamicAllocator
+{
+    QubitPool qubits;
+    size_type num_qubits{0};
+    size_type first_result{0};
+    size_type next_result{0};
+    size_type num_results{0};
+
+    //! Construct with the backend size and the first dynamic result
+    DynamicAllocator(EntryPointAttrs const& attrs, size_type first)
+        : num_qubits{attrs.required_num_qubits}
+        , first_result{first}
+        , next_result{first}
+        , num_results{attrs.required_num_results}
+    {
+    }
+
+    //! Release all qubits and results at the start of a shot
+    void clear()
+    {
+        qubits.clear();
+        next_result = first_result;
+    }
+};
+
+thread_local DynamicAllocator* dynamic_{nullptr};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Gates appended by compiled code on the current thread.
+ *
+ * Only programs compiled with \c ExecutorOptions::buffer_gates write to the
+ * buffer. Its storage is kept between executions to avoid reallocating.
+ */
+thread_local detail::GateBuffer gate_buffer_;
+thread_local std::vector<GateOp> gate_storage_;
+
+//! Number of gates buffered before they are sent to the backend
+constexpr size_type gate_buffer_capacity{256};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Send buffered gates to the quantum interface.
+ */
+void flush_gates()
+{
+    Span<GateOp const> ops{gate_buffer_.data, gate_buffer_.size};
+    gate_buffer_.size = 0;
+    q_interface_->apply(ops);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the current thread's gate buffer.
+ */
+detail::GateBuffer* gate_buffer()
+{
+    return &gate_buffer_;
+}
+
+//---------------------------------------------------------------------------//
+//!@{
+//! Get an interface after sending it any buffered gates
+QuantumInterface& quantum()
+{
+    if (gate_buffer_.size)
+    {
+        flush_gates();
+    }
+    return *q_interface_;
+}
+RuntimeInterface& runtime()
+{
+    if (gate_buffer_.size)
+    {
+        flush_gates();
+    }
+    return *r_interface_;
+}
+//!@}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the measured value of a result handle.
+ */
+QState read_result_handle(std::uintptr_t r)
+{
+    if (detail::is_constant_result(r))
+    {
+        return detail::constant_result(r);
+    }
+    return quantum().read_result(Result{r});
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get a new result for a measurement with dynamic result management.
+ */
+Result allocate_result()
+{
+    Result r{dynamic_->next_result++};
+    QIREE_VALIDATE(r.value < dynamic_->num_results,
+                   << "cannot allocate more than " << dynamic_->num_results
+                   << " results: the quantum interface is too small for "
+                      "the number of measurements");
+    return r;
+}
 
 //---------------------------------------------------------------------------//
 //! Generate a function name without a specialization suffix
@@ -55,24 +207,32 @@ static RuntimeInterface* r_interface_{nullptr};
 //---------------------------------------------------------------------------//
 std::uintptr_t QIREE_QIS_FUNCTION(m, body)(std::uintptr_t arg1)
 {
-    return q_interface_->m(Qubit{arg1}).value;
+    // Dynamic result management: measure into a new result (not generated)
+    Result r = allocate_result();
+    quantum().mz(Qubit{arg1}, r);
+    return r.value;
 }
 std::uintptr_t
 QIREE_QIS_FUNCTION(measure, body)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->measure(Array{arg1}, Array{arg2}).value;
+    return quantum().measure(Array{arg1}, Array{arg2}).value;
 }
 std::uintptr_t QIREE_QIS_FUNCTION(mresetz, body)(std::uintptr_t arg1)
 {
-    return q_interface_->mresetz(Qubit{arg1}).value;
+    // Dynamic result management: measure into a new result (not generated)
+    Result r = allocate_result();
+    QuantumInterface& qi = quantum();
+    qi.mz(Qubit{arg1}, r);
+    qi.reset(Qubit{arg1});
+    return r.value;
 }
 void QIREE_QIS_FUNCTION(mz, body)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->mz(Qubit{arg1}, Result{arg2});
+    return quantum().mz(Qubit{arg1}, Result{arg2});
 }
 bool QIREE_QIS_FUNCTION(read_result, body)(std::uintptr_t arg1)
 {
-    return static_cast<bool>(q_interface_->read_result(Result{arg1}));
+    return static_cast<bool>(read_result_handle(arg1));
 }
 //---------------------------------------------------------------------------//
 // GATES
@@ -81,175 +241,175 @@ void QIREE_QIS_FUNCTION(ccx, body)(std::uintptr_t arg1,
                                    std::uintptr_t arg2,
                                    std::uintptr_t arg3)
 {
-    return q_interface_->ccx(Qubit{arg1}, Qubit{arg2}, Qubit{arg3});
+    return quantum().ccx(Qubit{arg1}, Qubit{arg2}, Qubit{arg3});
 }
 void QIREE_QIS_FUNCTION(cnot, body)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->cnot(Qubit{arg1}, Qubit{arg2});
+    return quantum().cnot(Qubit{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(cx, body)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->cx(Qubit{arg1}, Qubit{arg2});
+    return quantum().cx(Qubit{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(cy, body)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->cy(Qubit{arg1}, Qubit{arg2});
+    return quantum().cy(Qubit{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(cz, body)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->cz(Qubit{arg1}, Qubit{arg2});
+    return quantum().cz(Qubit{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(exp, adj)(std::uintptr_t arg1,
                                   double arg2,
                                   std::uintptr_t arg3)
 {
-    return q_interface_->exp_adj(Array{arg1}, arg2, Array{arg3});
+    return quantum().exp_adj(Array{arg1}, arg2, Array{arg3});
 }
 void QIREE_QIS_FUNCTION(exp, body)(std::uintptr_t arg1,
                                    double arg2,
                                    std::uintptr_t arg3)
 {
-    return q_interface_->exp(Array{arg1}, arg2, Array{arg3});
+    return quantum().exp(Array{arg1}, arg2, Array{arg3});
 }
 void QIREE_QIS_FUNCTION(exp, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->exp(Array{arg1}, Tuple{arg2});
+    return quantum().exp(Array{arg1}, Tuple{arg2});
 }
 void QIREE_QIS_FUNCTION(exp, ctladj)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->exp_adj(Array{arg1}, Tuple{arg2});
+    return quantum().exp_adj(Array{arg1}, Tuple{arg2});
 }
 void QIREE_QIS_FUNCTION(h, body)(std::uintptr_t arg1)
 {
-    return q_interface_->h(Qubit{arg1});
+    return quantum().h(Qubit{arg1});
 }
 void QIREE_QIS_FUNCTION(h, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->h(Array{arg1}, Qubit{arg2});
+    return quantum().h(Array{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(r,
                         adj)(pauli_type arg1, double arg2, std::uintptr_t arg3)
 {
-    return q_interface_->r_adj(static_cast<Pauli>(arg1), arg2, Qubit{arg3});
+    return quantum().r_adj(static_cast<Pauli>(arg1), arg2, Qubit{arg3});
 }
 void QIREE_QIS_FUNCTION(r,
                         body)(pauli_type arg1, double arg2, std::uintptr_t arg3)
 {
-    return q_interface_->r(static_cast<Pauli>(arg1), arg2, Qubit{arg3});
+    return quantum().r(static_cast<Pauli>(arg1), arg2, Qubit{arg3});
 }
 void QIREE_QIS_FUNCTION(r, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->r(Array{arg1}, Tuple{arg2});
+    return quantum().r(Array{arg1}, Tuple{arg2});
 }
 void QIREE_QIS_FUNCTION(r, ctladj)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->r_adj(Array{arg1}, Tuple{arg2});
+    return quantum().r_adj(Array{arg1}, Tuple{arg2});
 }
 void QIREE_QIS_FUNCTION(reset, body)(std::uintptr_t arg1)
 {
-    return q_interface_->reset(Qubit{arg1});
+    return quantum().reset(Qubit{arg1});
 }
 void QIREE_QIS_FUNCTION(rx, body)(double arg1, std::uintptr_t arg2)
 {
-    return q_interface_->rx(arg1, Qubit{arg2});
+    return quantum().rx(arg1, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(rx, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->rx(Array{arg1}, Tuple{arg2});
+    return quantum().rx(Array{arg1}, Tuple{arg2});
 }
 void QIREE_QIS_FUNCTION(rxx, body)(double arg1,
                                    std::uintptr_t arg2,
                                    std::uintptr_t arg3)
 {
-    return q_interface_->rxx(arg1, Qubit{arg2}, Qubit{arg3});
+    return quantum().rxx(arg1, Qubit{arg2}, Qubit{arg3});
 }
 void QIREE_QIS_FUNCTION(ry, body)(double arg1, std::uintptr_t arg2)
 {
-    return q_interface_->ry(arg1, Qubit{arg2});
+    return quantum().ry(arg1, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(ry, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->ry(Array{arg1}, Tuple{arg2});
+    return quantum().ry(Array{arg1}, Tuple{arg2});
 }
 void QIREE_QIS_FUNCTION(ryy, body)(double arg1,
                                    std::uintptr_t arg2,
                                    std::uintptr_t arg3)
 {
-    return q_interface_->ryy(arg1, Qubit{arg2}, Qubit{arg3});
+    return quantum().ryy(arg1, Qubit{arg2}, Qubit{arg3});
 }
 void QIREE_QIS_FUNCTION(rz, body)(double arg1, std::uintptr_t arg2)
 {
-    return q_interface_->rz(arg1, Qubit{arg2});
+    return quantum().rz(arg1, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(rz, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->rz(Array{arg1}, Tuple{arg2});
+    return quantum().rz(Array{arg1}, Tuple{arg2});
 }
 void QIREE_QIS_FUNCTION(rzz, body)(double arg1,
                                    std::uintptr_t arg2,
                                    std::uintptr_t arg3)
 {
-    return q_interface_->rzz(arg1, Qubit{arg2}, Qubit{arg3});
+    return quantum().rzz(arg1, Qubit{arg2}, Qubit{arg3});
 }
 void QIREE_QIS_FUNCTION(s, adj)(std::uintptr_t arg1)
 {
-    return q_interface_->s_adj(Qubit{arg1});
+    return quantum().s_adj(Qubit{arg1});
 }
 void QIREE_QIS_FUNCTION(s, body)(std::uintptr_t arg1)
 {
-    return q_interface_->s(Qubit{arg1});
+    return quantum().s(Qubit{arg1});
 }
 void QIREE_QIS_FUNCTION(s, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->s(Array{arg1}, Qubit{arg2});
+    return quantum().s(Array{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(s, ctladj)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->s_adj(Array{arg1}, Qubit{arg2});
+    return quantum().s_adj(Array{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(swap, body)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->swap(Qubit{arg1}, Qubit{arg2});
+    return quantum().swap(Qubit{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(t, adj)(std::uintptr_t arg1)
 {
-    return q_interface_->t_adj(Qubit{arg1});
+    return quantum().t_adj(Qubit{arg1});
 }
 void QIREE_QIS_FUNCTION(t, body)(std::uintptr_t arg1)
 {
-    return q_interface_->t(Qubit{arg1});
+    return quantum().t(Qubit{arg1});
 }
 void QIREE_QIS_FUNCTION(t, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->t(Array{arg1}, Qubit{arg2});
+    return quantum().t(Array{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(t, ctladj)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->t_adj(Array{arg1}, Qubit{arg2});
+    return quantum().t_adj(Array{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(x, body)(std::uintptr_t arg1)
 {
-    return q_interface_->x(Qubit{arg1});
+    return quantum().x(Qubit{arg1});
 }
 void QIREE_QIS_FUNCTION(x, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->x(Array{arg1}, Qubit{arg2});
+    return quantum().x(Array{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(y, body)(std::uintptr_t arg1)
 {
-    return q_interface_->y(Qubit{arg1});
+    return quantum().y(Qubit{arg1});
 }
 void QIREE_QIS_FUNCTION(y, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->y(Array{arg1}, Qubit{arg2});
+    return quantum().y(Array{arg1}, Qubit{arg2});
 }
 void QIREE_QIS_FUNCTION(z, body)(std::uintptr_t arg1)
 {
-    return q_interface_->z(Qubit{arg1});
+    return quantum().z(Qubit{arg1});
 }
 void QIREE_QIS_FUNCTION(z, ctl)(std::uintptr_t arg1, std::uintptr_t arg2)
 {
-    return q_interface_->z(Array{arg1}, Qubit{arg2});
+    return quantum().z(Array{arg1}, Qubit{arg2});
 }
 //---------------------------------------------------------------------------//
 // ASSERTIONS
@@ -262,13 +422,13 @@ void QIREE_QIS_FUNCTION(assertmeasurementprobability,
                               std::uintptr_t arg5,
                               double arg6)
 {
-    return q_interface_->assertmeasurementprobability(
+    return quantum().assertmeasurementprobability(
         Array{arg1}, Array{arg2}, Result{arg3}, arg4, String{arg5}, arg6);
 }
 void QIREE_QIS_FUNCTION(assertmeasurementprobability, ctl)(std::uintptr_t arg1,
                                                            std::uintptr_t arg2)
 {
-    return q_interface_->assertmeasurementprobability(Array{arg1}, Tuple{arg2});
+    return quantum().assertmeasurementprobability(Array{arg1}, Tuple{arg2});
 }
 
 //---------------------------------------------------------------------------//
@@ -276,74 +436,90 @@ void QIREE_QIS_FUNCTION(assertmeasurementprobability, ctl)(std::uintptr_t arg1,
 //---------------------------------------------------------------------------//
 void QIREE_RT_FUNCTION(initialize)(OptionalCString env)
 {
-    return r_interface_->initialize(env);
+    return runtime().initialize(env);
 }
 void QIREE_RT_FUNCTION(array_record_output)(size_type s, OptionalCString tag)
 {
-    return r_interface_->array_record_output(s, tag);
+    return runtime().array_record_output(s, tag);
 }
 void QIREE_RT_FUNCTION(tuple_record_output)(size_type s, OptionalCString tag)
 {
-    return r_interface_->tuple_record_output(s, tag);
+    return runtime().tuple_record_output(s, tag);
 }
 void QIREE_RT_FUNCTION(result_record_output)(std::uintptr_t r,
                                              OptionalCString tag)
 {
-    return r_interface_->result_record_output(Result{r}, tag);
+    if (detail::is_constant_result(r))
+    {
+        return runtime().constant_record_output(detail::constant_result(r),
+                                                tag);
+    }
+    return runtime().result_record_output(Result{r}, tag);
+}
+std::uintptr_t QIREE_RT_FUNCTION(qubit_allocate)()
+{
+    Qubit q = dynamic_->qubits.allocate();
+    QIREE_VALIDATE(q.value < dynamic_->num_qubits,
+                   << "cannot allocate more than " << dynamic_->num_qubits
+                   << " dynamic qubits: the quantum interface is too small "
+                      "for the number of live qubits");
+    return q.value;
+}
+void QIREE_RT_FUNCTION(qubit_release)(std::uintptr_t q)
+{
+    return dynamic_->qubits.release(Qubit{q});
+}
+std::uintptr_t QIREE_RT_FUNCTION(result_get_zero)()
+{
+    return detail::zero_result;
+}
+std::uintptr_t QIREE_RT_FUNCTION(result_get_one)()
+{
+    return detail::one_result;
+}
+bool QIREE_RT_FUNCTION(result_equal)(std::uintptr_t r1, std::uintptr_t r2)
+{
+    return r1 == r2 || read_result_handle(r1) == read_result_handle(r2);
+}
+void QIREE_RT_FUNCTION(result_update_reference_count)(std::uintptr_t,
+                                                      std::int32_t)
+{
+    // Result handles own no memory
 }
 
 //!@}
+
 //---------------------------------------------------------------------------//
-}  // namespace
+//!@{
+//! Shot loop hooks
+void begin_shot()
+{
+    shot_loop_->in_shot = true;
+    dynamic_->clear();
+    quantum().set_up(*shot_loop_->attrs);
+}
+void end_shot(size_type shot)
+{
+    QuantumInterface& qi = quantum();
+    shot_loop_->in_shot = false;
+    qi.tear_down();
+    if (*shot_loop_->on_shot)
+    {
+        (*shot_loop_->on_shot)(shot);
+    }
+}
+//!@}
 
 //---------------------------------------------------------------------------//
 /*!
- * Construct with a QIR input filename.
+ * Pass every QIR function implemented by QIR-EE to a binding function.
+ *
+ * The binder is called with the QIR symbol name and a pointer to the wrapper
+ * function.
  */
-Executor::Executor(Module&& module)
-    : entrypoint_{module.entrypoint_}, module_{module.module_.get()}
+template<class F>
+void bind_functions(F&& bind_function)
 {
-    QIREE_EXPECT(module);
-    QIREE_EXPECT(entrypoint_ && module_);
-
-    // Save module and entry point attributes
-    entry_point_attrs_ = module.load_entry_point_attrs();
-    module_flags_ = module.load_module_flags();
-
-    // Initialize LLVM
-    llvm::InitializeNativeTarget();
-    llvm::InitializeNativeTargetAsmPrinter();
-    LLVMLinkInMCJIT();
-
-    // Create execution engine by capturing the module
-    ee_ = [&module] {
-        llvm::EngineBuilder builder{std::move(module.module_)};
-
-        // Pass a reference to a string for diagnosing errors
-        std::string err_str;
-        builder.setErrorStr(&err_str);
-
-        // Set execution options
-        llvm::TargetOptions opts;
-        opts.ExceptionModel = llvm::ExceptionHandling::DwarfCFI;
-        builder.setTargetOptions(opts);
-
-        // Create the builder, or throw an exception with the failure
-        std::unique_ptr<llvm::ExecutionEngine> ee{builder.create()};
-        QIREE_VALIDATE(ee, << "failed to create execution engine: " << err_str);
-        return ee;
-    }();
-
-    // Suppress symbol lookup in system dynamic libraries
-    ee_->DisableSymbolSearching(true);
-
-    // Add "lazy function creator" that just gives a more informative message
-    ee_->InstallLazyFunctionCreator([](std::string const& s) -> void* {
-        QIREE_NOT_IMPLEMENTED(s.c_str());
-    });
-
-    // Bind functions if available
-    detail::GlobalMapper bind_function(*module_, ee_.get());
 #define QIREE_BIND_RT_FUNCTION(FUNC) \
     bind_function("__quantum__rt__" #FUNC, QIREE_RT_FUNCTION(FUNC))
 #define QIREE_BIND_QIS_FUNCTION(FUNC, SUFFIX)            \
@@ -404,41 +580,686 @@ Executor::Executor(Module&& module)
     QIREE_BIND_RT_FUNCTION(array_record_output);
     QIREE_BIND_RT_FUNCTION(tuple_record_output);
     QIREE_BIND_RT_FUNCTION(result_record_output);
+    QIREE_BIND_RT_FUNCTION(qubit_allocate);
+    QIREE_BIND_RT_FUNCTION(qubit_release);
+    QIREE_BIND_RT_FUNCTION(result_get_zero);
+    QIREE_BIND_RT_FUNCTION(result_get_one);
+    QIREE_BIND_RT_FUNCTION(result_equal);
+    QIREE_BIND_RT_FUNCTION(result_update_reference_count);
+
+    bind_function(detail::begin_shot_name, begin_shot);
+    bind_function(detail::end_shot_name, end_shot);
+    bind_function(detail::gate_buffer_name, gate_buffer);
+    bind_function(detail::flush_gates_name, flush_gates);
 #undef QIREE_BIND_RT_FUNCTION
 #undef QIREE_BIND_QIS_FUNCTION
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the names of all QIR functions implemented by QIR-EE.
+ */
+std::unordered_set<std::string_view> bound_names()
+{
+    std::unordered_set<std::string_view> result;
+    bind_functions([&result](char const* name, auto*) { result.insert(name); });
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Substitute native implementations before binding QIR functions.
+ *
+ * The returned binder forwards to the given one, replacing the wrapper
+ * function with an override of the same name if present.
+ */
+template<class F>
+auto override_functions(FunctionOverrides const& overrides, F&& bind_function)
+{
+    return [&overrides, &bind_function](char const* name, auto* func) {
+        if (auto iter = overrides.find(name); iter != overrides.end())
+        {
+            func = reinterpret_cast<decltype(func)>(iter->second);
+        }
+        bind_function(name, func);
+    };
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Check that every external function called by the module is implemented.
+ *
+ * With lazy compilation, an unresolved symbol would otherwise only be
+ * discovered (fatally) when the function calling it is first executed.
+ */
+void check_declarations(llvm::Module const& mod)
+{
+    auto const bound = bound_names();
+    for (llvm::Function const& f : mod)
+    {
+        if (f.isDeclaration() && !f.isIntrinsic() && !f.use_empty()
+            && !bound.count(std::string_view(f.getName())))
+        {
+            QIREE_NOT_IMPLEMENTED(f.getName().str().c_str());
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Whether the module calls the given function.
+ */
+bool uses_function(llvm::Module const& mod, llvm::StringRef name)
+{
+    llvm::Function const* f = mod.getFunction(name);
+    return f && !f->use_empty();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Whether the program's QIR calls cannot depend on measurement outcomes.
+ *
+ * The only way for the classical program to observe the quantum state is
+ * through instructions that return a value. Programs that never call them
+ * (which includes all base profile programs) make the same calls every shot.
+ */
+bool is_shot_invariant(llvm::Module const& mod)
+{
+    for (char const* name : {"__quantum__qis__m__body",
+                             "__quantum__qis__measure__body",
+                             "__quantum__qis__mresetz__body",
+                             "__quantum__qis__read_result__body",
+                             "__quantum__rt__result_equal"})
+    {
+        if (uses_function(mod, name))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Throw if an LLVM operation failed.
+ */
+template<class T>
+T take_or_throw(llvm::Expected<T>&& value, char const* what)
+{
+    if (!value)
+    {
+        QIREE_VALIDATE(false,
+                       << what << ": " << llvm::toString(value.takeError()));
+    }
+    return std::move(*value);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get a string corresponding to a JIT engine.
+ */
+char const* to_cstring(JitEngine value)
+{
+    switch (value)
+    {
+        case JitEngine::mcjit:
+            return "mcjit";
+        case JitEngine::orc:
+            return "orc";
+        case JitEngine::orc_lazy:
+            return "orc-lazy";
+    }
+    return "";
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get a JIT engine from a string.
+ */
+JitEngine to_jit_engine(std::string const& s)
+{
+    for (auto e : {JitEngine::mcjit, JitEngine::orc, JitEngine::orc_lazy})
+    {
+        if (s == to_cstring(e))
+        {
+            return e;
+        }
+    }
+    QIREE_VALIDATE(false, << "invalid JIT engine '" << s << "'");
+    return {};
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get a string corresponding to an optimization level.
+ */
+char const* to_cstring(OptLevel value)
+{
+    switch (value)
+    {
+        case OptLevel::O0:
+            return "O0";
+        case OptLevel::O1:
+            return "O1";
+        case OptLevel::O2:
+            return "O2";
+        case OptLevel::O3:
+            return "O3";
+    }
+    return "";
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with a QIR module using default options.
+ */
+Executor::Executor(Module&& module) : Executor{std::move(module), {}} {}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with a QIR module and compilation options.
+ */
+Executor::Executor(Module&& module, ExecutorOptions const& options)
+    : Executor{std::move(module), options, {}}
+{
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with options and replacement QIR function implementations.
+ *
+ * The overrides are bound to the JIT in place of QIR-EE's wrappers that call
+ * through the virtual quantum and runtime interfaces. This is used by
+ * \c BoundExecutor to call a concrete backend directly.
+ */
+Executor::Executor(Module&& module,
+                   ExecutorOptions const& options,
+                   FunctionOverrides const& overrides)
+{
+    QIREE_EXPECT(module);
+    llvm::Function const* entrypoint = module.entrypoint_;
+    QIREE_EXPECT(entrypoint);
+
+    // Transform and compile the IR without interference from other threads
+    // that share the context
+    std::optional<llvm::orc::ThreadSafeContext::Lock> context_lock;
+    if (module.context_)
+    {
+        context_lock.emplace(module.context_->getLock());
+    }
+
+    QIREE_VALIDATE(entrypoint->arg_empty(),
+                   << "entry point '" << entrypoint->getName().str()
+                   << "' must not take any arguments");
+
+    // Save module and entry point attributes
+    entry_point_attrs_ = module.load_entry_point_attrs();
+    module_flags_ = module.load_module_flags();
+
+    // Read only the function bodies that lazily loaded bitcode needs
+    num_unloaded_
+        = detail::materialize_reachable(*module.module_, *module.entrypoint_);
+    execution_class_ = module.execution_class();
+
+    if (entry_point_attrs_.required_num_qubits == 0
+        && uses_function(*module.module_, "__quantum__rt__qubit_allocate"))
+    {
+        // Size the backend for the peak number of live qubits if known, or
+        // else for every allocation on any path through the program
+        CircuitAnalysis analysis{module};
+        std::optional<size_type> num_qubits = analysis.num_qubits();
+        if (!analysis.complete())
+        {
+            num_qubits = detail::max_num_calls(
+                *module.entrypoint_, {"__quantum__rt__qubit_allocate"});
+            QIREE_VALIDATE(num_qubits,
+                           << "cannot bound the number of dynamically "
+                              "allocated qubits: qubits allocated in a loop "
+                              "or recursion with measurement-dependent "
+                              "control flow require the "
+                              "'required_num_qubits' entry point attribute");
+            num_qubits = std::max(*num_qubits, analysis.num_qubits());
+        }
+        entry_point_attrs_.required_num_qubits = *num_qubits;
+    }
+
+    num_static_results_ = entry_point_attrs_.required_num_results;
+    if (uses_function(*module.module_, "__quantum__qis__m__body")
+        || uses_function(*module.module_, "__quantum__qis__mresetz__body"))
+    {
+        // Add a result for every measurement on any path through the program
+        auto num_results = detail::max_num_calls(
+            *module.entrypoint_,
+            {"__quantum__qis__m__body", "__quantum__qis__mresetz__body"});
+        QIREE_VALIDATE(num_results,
+                       << "cannot bound the number of dynamically allocated "
+                          "results: measurements returning a result cannot "
+                          "be repeated in a loop or recursion");
+        entry_point_attrs_.required_num_results += *num_results;
+    }
+
+    if (module.num_linked() > 0)
+    {
+        // Expose library subroutines to the classical optimizations
+        detail::inline_linked(*module.module_, *module.entrypoint_);
+    }
 
+    // Simplify classical control flow around the QIR calls
+    opt_stats_
+        = detail::optimize(*module.module_, *module.entrypoint_, options);
+
+    if (options.buffer_gates)
+    {
+        // Replace gate calls with inlined appends to a buffer
+        opt_stats_.gates_buffered
+            = detail::add_gate_buffer(*module.module_, overrides);
+        buffer_gates_ = opt_stats_.gates_buffered > 0;
+        if (buffer_gates_)
+        {
+            detail::inline_gate_buffer(*module.module_, options.opt_level);
+            detail::count_instructions(*module.module_,
+                                       &opt_stats_.instructions_after,
+                                       &opt_stats_.calls_after);
+        }
+    }
+
+    // Reject unimplemented QIR functions before compiling anything
+    check_declarations(*module.module_);
+    if (!overrides.empty())
+    {
+        auto const bound = bound_names();
+        for (auto const& [name, func] : overrides)
+        {
+            QIREE_VALIDATE(bound.count(name),
+                           << "cannot override unknown QIR function '" << name
+                           << "'");
+            QIREE_VALIDATE(func,
+                           << "null override for QIR function '" << name
+                           << "'");
+        }
+    }
+    shot_invariant_ = is_shot_invariant(*module.module_);
+
+    // Add a loop over shots that calls the entry point
+    detail::add_shot_loop(*module.module_, *module.entrypoint_);
+
+    // Keep the module's context alive as long as the compiled code
+    context_ = std::move(module.context_);
+
+    // ORC requires a thread-safe context that owns the module: an externally
+    // created module is in a context we don't own, so compile it with MCJIT
+    JitEngine engine = options.engine;
+    if (!context_)
+    {
+        engine = JitEngine::mcjit;
+    }
+
+    // Initialize LLVM
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    if (!options.cache_dir.empty())
+    {
+        // Objects depend on the engine's code generation settings (the IR
+        // optimization level is reflected in the hashed module)
+        cache_ = std::make_unique<detail::DiskObjectCache>(
+            options.cache_dir, to_cstring(engine));
+    }
+
+    switch (engine)
+    {
+        case JitEngine::mcjit:
+            this->build_mcjit(std::move(module), overrides);
+            break;
+        case JitEngine::orc:
+            this->build_orc(
+                std::move(module), overrides, /* lazy = */ false);
+            break;
+        case JitEngine::orc_lazy:
+            this->build_orc(std::move(module), overrides, /* lazy = */ true);
+            break;
+    }
+
+    QIREE_ENSURE(entry_ && loop_);
     QIREE_ENSURE(!module);
 }
 
 //---------------------------------------------------------------------------//
-//! Default destructor
-Executor::~Executor() = default;
+/*!
+ * Destroy the compiled module while holding its context's lock.
+ */
+Executor::~Executor()
+{
+    if (context_)
+    {
+        auto lock = context_->getLock();
+        jit_.reset();
+        ee_.reset();
+    }
+}
 
 //---------------------------------------------------------------------------//
 /*!
  * Execute with the given interface functions.
+ *
+ * The interfaces are bound to the calling thread for the duration of the
+ * call, so multiple threads may execute the same instance simultaneously as
+ * long as each uses its own quantum and runtime interfaces.
  */
 void Executor::operator()(QuantumInterface& qi, RuntimeInterface& ri) const
 {
-    QIREE_EXPECT(ee_);
+    QIREE_EXPECT(entry_);
 
     QIREE_VALIDATE(!q_interface_ && !r_interface_,
-                   << "cannot call LLVM executor recursively or in MT "
-                      "environment (for now)");
+                   << "cannot call LLVM executor recursively");
+    DynamicAllocator dynamic{entry_point_attrs_, num_static_results_};
     detail::EndGuard on_end_scope_([] {
         q_interface_->tear_down();
         q_interface_ = nullptr;
         r_interface_ = nullptr;
+        dynamic_ = nullptr;
+        gate_buffer_ = {};
     });
     q_interface_ = &qi;
     r_interface_ = &ri;
+    dynamic_ = &dynamic;
+    this->begin_buffering();
 
     // Call setup on the interface
     qi.set_up(entry_point_attrs_);
 
-    // Execute the main function
-    auto result = ee_->runFunction(entrypoint_, {});
-    QIREE_DISCARD(result);
+    // Execute the main function and send any remaining gates
+    (*entry_)();
+    if (buffer_gates_ && gate_buffer_.size)
+    {
+        flush_gates();
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Execute many shots in a compiled loop.
+ *
+ * This is equivalent to calling the executor \c num_shots times, invoking the
+ * (optional) callback with the shot index after each shot's \c tear_down ,
+ * but the loop itself is compiled with the program: the per-shot overhead is
+ * two direct calls rather than the setup of a new execution.
+ */
+void Executor::run_shots(QuantumInterface& qi,
+                         RuntimeInterface& ri,
+                         size_type num_shots,
+                         ShotCallback const& on_shot) const
+{
+    QIREE_EXPECT(loop_);
+
+    QIREE_VALIDATE(!q_interface_ && !r_interface_,
+                   << "cannot call LLVM executor recursively");
+    ShotLoopState state;
+    state.attrs = &entry_point_attrs_;
+    state.on_shot = &on_shot;
+    DynamicAllocator dynamic{entry_point_attrs_, num_static_results_};
+    detail::EndGuard on_end_scope_([&state] {
+        if (state.in_shot)
+        {
+            // An exception interrupted a shot
+            q_interface_->tear_down();
+        }
+        q_interface_ = nullptr;
+        r_interface_ = nullptr;
+        shot_loop_ = nullptr;
+        dynamic_ = nullptr;
+        gate_buffer_ = {};
+    });
+    q_interface_ = &qi;
+    r_interface_ = &ri;
+    shot_loop_ = &state;
+    dynamic_ = &dynamic;
+    this->begin_buffering();
+
+    (*loop_)(num_shots);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Execute while recording the QIR calls.
+ *
+ * The tape is cleared before recording. The result is true if the tape can be
+ * replayed, i.e. the program did not read any measurement outcomes.
+ */
+bool Executor::record(QuantumInterface& qi,
+                      RuntimeInterface& ri,
+                      GateTape* tape) const
+{
+    QIREE_EXPECT(tape);
+    tape->clear();
+
+    RecordingQuantum record_qi(qi, tape);
+    RecordingRuntime record_ri(ri, tape);
+    (*this)(record_qi, record_ri);
+    return record_qi.replayable();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Repeat a recorded execution without running the compiled program.
+ *
+ * This is equivalent to calling the executor if the tape was recorded from a
+ * shot-invariant program.
+ */
+void Executor::replay(GateTape const& tape,
+                      QuantumInterface& qi,
+                      RuntimeInterface& ri) const
+{
+    detail::EndGuard on_end_scope_([&qi] { qi.tear_down(); });
+    qi.set_up(entry_point_attrs_);
+    ::qiree::replay(tape, qi, ri);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Repeat a recorded execution on a different number of qubits.
+ *
+ * This is used to replay a tape whose qubits were renumbered by
+ * \c compact_qubits : the quantum interface is set up with the given number
+ * of qubits rather than the number required by the entry point.
+ */
+void Executor::replay(GateTape const& tape,
+                      size_type num_qubits,
+                      QuantumInterface& qi,
+                      RuntimeInterface& ri) const
+{
+    EntryPointAttrs attrs = entry_point_attrs_;
+    attrs.required_num_qubits = num_qubits;
+
+    detail::EndGuard on_end_scope_([&qi] { qi.tear_down(); });
+    qi.set_up(attrs);
+    ::qiree::replay(tape, qi, ri);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get compilation statistics.
+ */
+ExecutorStats Executor::stats() const
+{
+    ExecutorStats result;
+    result.optimization = opt_stats_;
+    result.unloaded_functions = num_unloaded_;
+    if (cache_)
+    {
+        result.cache_hits = cache_->num_hits();
+        result.cache_misses = cache_->num_misses();
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Prepare the current thread's gate buffer if the program uses it.
+ */
+void Executor::begin_buffering() const
+{
+    if (!buffer_gates_)
+    {
+        return;
+    }
+    gate_storage_.resize(gate_buffer_capacity);
+    gate_buffer_.data = gate_storage_.data();
+    gate_buffer_.size = 0;
+    gate_buffer_.capacity = gate_storage_.size();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Compile the whole module with MCJIT.
+ */
+void Executor::build_mcjit(Module&& module,
+                           FunctionOverrides const& overrides)
+{
+    LLVMLinkInMCJIT();
+
+    llvm::Module const& mod = *module.module_;
+    llvm::Function* entrypoint = module.entrypoint_;
+    llvm::Function* loop = module.module_->getFunction(detail::shot_loop_name);
+
+    // Create execution engine by capturing the module
+    ee_ = [&module] {
+        llvm::EngineBuilder builder{std::move(module.module_)};
+
+        // Pass a reference to a string for diagnosing errors
+        std::string err_str;
+        builder.setErrorStr(&err_str);
+
+        // Set execution options
+        llvm::TargetOptions opts;
+        opts.ExceptionModel = llvm::ExceptionHandling::DwarfCFI;
+        builder.setTargetOptions(opts);
+
+        // Create the builder, or throw an exception with the failure
+        std::unique_ptr<llvm::ExecutionEngine> ee{builder.create()};
+        QIREE_VALIDATE(ee, << "failed to create execution engine: " << err_str);
+        return ee;
+    }();
+
+    // Suppress symbol lookup in system dynamic libraries
+    ee_->DisableSymbolSearching(true);
+
+    // Add "lazy function creator" that just gives a more informative message
+    ee_->InstallLazyFunctionCreator([](std::string const& s) -> void* {
+        QIREE_NOT_IMPLEMENTED(s.c_str());
+    });
+
+    // Bind functions if available
+    bind_functions(
+        override_functions(overrides, detail::GlobalMapper(mod, ee_.get())));
+
+    // Reuse previously compiled objects
+    if (cache_)
+    {
+        ee_->setObjectCache(cache_.get());
+    }
+
+    // Compile the module and save the native entry point
+    ee_->finalizeObject();
+    entry_ = reinterpret_cast<EntryFunction>(
+        ee_->getPointerToFunction(entrypoint));
+    QIREE_VALIDATE(entry_,
+                   << "failed to compile entry point '"
+                   << entrypoint->getName().str() << "'");
+    loop_ = reinterpret_cast<LoopFunction>(ee_->getPointerToFunction(loop));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Add the module to an ORC JIT and look up the entry point.
+ *
+ * The eager JIT compiles the whole module during the entry point lookup. The
+ * lazy JIT instead emits stubs that compile each function the first time it
+ * is called; compilation is serialized by the module's context lock, so
+ * concurrent first calls are safe.
+ */
+void Executor::build_orc(Module&& module,
+                         FunctionOverrides const& overrides,
+                         bool lazy)
+{
+    QIREE_EXPECT(context_);
+    std::string const entry_name = module.entrypoint_->getName().str();
+    llvm::orc::ThreadSafeModule tsm{std::move(module.module_), *context_};
+
+    // Compile with a (possibly caching) target machine
+    auto make_compiler = [cache = cache_.get()](
+                             llvm::orc::JITTargetMachineBuilder jtmb)
+        -> llvm::Expected<
+            std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+        auto tm = jtmb.createTargetMachine();
+        if (!tm)
+        {
+            return tm.takeError();
+        }
+        return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(
+            std::move(*tm), cache);
+    };
+
+    if (lazy)
+    {
+        llvm::orc::LLLazyJITBuilder builder;
+        builder.setCompileFunctionCreator(make_compiler);
+        auto jit = take_or_throw(builder.create(),
+                                 "failed to create lazy ORC JIT");
+        jit->setPartitionFunction(
+            llvm::orc::CompileOnDemandLayer::compileRequested);
+        jit_ = std::move(jit);
+    }
+    else
+    {
+        llvm::orc::LLJITBuilder builder;
+        builder.setCompileFunctionCreator(make_compiler);
+        jit_ = take_or_throw(builder.create(), "failed to create ORC JIT");
+    }
+
+    // Define absolute addresses for the QIR functions used by the module
+    tsm.withModuleDo([this, &overrides](llvm::Module& mod) {
+        detail::SymbolMapper bind_function(mod, *jit_);
+        bind_functions(override_functions(overrides, bind_function));
+        bind_function.define();
+    });
+
+    llvm::Error err = llvm::Error::success();
+    if (lazy)
+    {
+        err = static_cast<llvm::orc::LLLazyJIT&>(*jit_).addLazyIRModule(
+            std::move(tsm));
+    }
+    else
+    {
+        err = jit_->addIRModule(std::move(tsm));
+    }
+    if (err)
+    {
+        QIREE_VALIDATE(false,
+                       << "failed to add module to ORC JIT: "
+                       << llvm::toString(std::move(err)));
+    }
+
+    // Look up (and for the eager JIT, compile) the entry point
+    auto addr = take_or_throw(jit_->lookup(entry_name),
+                              "failed to compile entry point");
+    auto loop_addr = take_or_throw(jit_->lookup(detail::shot_loop_name),
+                                   "failed to compile shot loop");
+#if LLVM_VERSION_MAJOR >= 15
+    entry_ = addr.toPtr<EntryFunction>();
+    loop_ = loop_addr.toPtr<LoopFunction>();
+#else
+    entry_
+        = llvm::jitTargetAddressToFunction<EntryFunction>(addr.getAddress());
+    loop_ = llvm::jitTargetAddressToFunction<LoopFunction>(
+        loop_addr.getAddress());
+#endif
+    QIREE_VALIDATE(entry_,
+                   << "failed to compile entry point '" << entry_name << "'");
 }
 
 //---------------------------------------------------------------------------//
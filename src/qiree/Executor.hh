@@ -7,36 +7,175 @@
 //---------------------------------------------------------------------------//
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "Macros.hh"
 #include "Types.hh"
 
 namespace llvm
 {
-class Module;
 class ExecutionEngine;
-class Function;
+namespace orc
+{
+class LLJIT;
+class ThreadSafeContext;
+}  // namespace orc
 }  // namespace llvm
 
 namespace qiree
 {
+namespace detail
+{
+class DiskObjectCache;
+}  // namespace detail
+
 //---------------------------------------------------------------------------//
+class GateTape;
 class Module;
 class QuantumInterface;
 class RuntimeInterface;
 
+//---------------------------------------------------------------------------//
+//! JIT compilation strategy
+enum class JitEngine
+{
+    mcjit,  //!< Compile the whole module up front with MCJIT
+    orc,  //!< Compile the whole module up front with ORC LLJIT
+    orc_lazy,  //!< Compile each function on its first call with ORC LLLazyJIT
+};
+
+//---------------------------------------------------------------------------//
+//! LLVM IR optimization level applied before JIT compilation
+enum class OptLevel
+{
+    O0,  //!< No IR optimization
+    O1,  //!< Fast optimizations
+    O2,  //!< Default optimizations, including inlining and loop unrolling
+    O3,  //!< Aggressive optimizations
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Options for compiling a QIR module.
+ */
+struct ExecutorOptions
+{
+    //! JIT compilation strategy (MCJIT for modules without a known context)
+    JitEngine engine{JitEngine::orc_lazy};
+    //! IR optimization level
+    OptLevel opt_level{OptLevel::O0};
+    //! Directory for reusing compiled objects (empty to disable caching)
+    std::string cache_dir;
+    //! Cancel and merge adjacent gates before compiling
+    bool simplify_gates{false};
+    //! Remove gates that cannot affect the recorded results
+    bool prune_lightcone{false};
+    //! Compile gates as appends to a buffer that is sent to the backend later
+    bool buffer_gates{false};
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Static instruction counts before and after IR optimization.
+ *
+ * Calls to LLVM intrinsics are excluded from the call counts. Loop unrolling
+ * can increase the static counts even though fewer instructions execute per
+ * shot.
+ */
+struct OptimizationStats
+{
+    size_type instructions_before{};
+    size_type instructions_after{};
+    size_type calls_before{};
+    size_type calls_after{};
+    size_type gates_removed{};  //!< Calls removed by gate simplification
+    size_type gates_pruned{};  //!< Calls outside the outputs' lightcone
+    size_type gates_buffered{};  //!< QIS functions compiled into the buffer
+
+    //! Net number of instructions removed
+    long instructions_removed() const
+    {
+        return static_cast<long>(instructions_before)
+               - static_cast<long>(instructions_after);
+    }
+
+    //! Net number of calls removed
+    long calls_removed() const
+    {
+        return static_cast<long>(calls_before)
+               - static_cast<long>(calls_after);
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Compilation statistics for an executor.
+ *
+ * With the lazy engine, modules are compiled (or loaded from the cache) as
+ * their functions are first called, so these may increase after
+ * construction.
+ */
+struct ExecutorStats
+{
+    size_type cache_hits{};  //!< Objects loaded from the cache
+    size_type cache_misses{};  //!< Objects compiled and saved to the cache
+    size_type unloaded_functions{};  //!< Lazy bitcode functions never read
+    OptimizationStats optimization;  //!< Effect of IR optimization
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Native implementations of QIR functions, keyed by symbol name.
+ *
+ * Each function pointer must have the same signature as QIR-EE's wrapper for
+ * that symbol, e.g. \c void(std::uintptr_t) for \c __quantum__qis__h__body .
+ */
+using FunctionOverrides = std::unordered_map<std::string, void (*)()>;
+
+//---------------------------------------------------------------------------//
+// Get a string corresponding to a JIT engine
+char const* to_cstring(JitEngine value);
+
+// Get a JIT engine from a string
+JitEngine to_jit_engine(std::string const& s);
+
+// Get a string corresponding to an optimization level
+char const* to_cstring(OptLevel value);
+
 //---------------------------------------------------------------------------//
 /*!
  * Set up and run an LLVM Execution Engine that wraps QIR.
+ *
+ * The module is compiled at construction (or, with the lazy ORC engine, each
+ * function is compiled on its first call). Symbols not provided by QIR-EE are
+ * rejected up front. Calling the executor is thread-safe: each invocation
+ * binds the given interfaces to the calling thread, so independent backends
+ * can run shots concurrently.
  */
 class Executor
 {
   public:
-    // Construct with a QIR input filename and function name
+    //!@{
+    //! \name Type aliases
+    //! Function called after each shot with the shot index
+    using ShotCallback = std::function<void(size_type)>;
+    //!@}
+
+  public:
+    // Construct with a QIR module using default options
     explicit Executor(Module&& module);
 
+    // Construct with a QIR module and compilation options
+    Executor(Module&& module, ExecutorOptions const& options);
+
+    // Construct with options and replacement QIR function implementations
+    Executor(Module&& module,
+             ExecutorOptions const& options,
+             FunctionOverrides const& overrides);
+
     // Default destructor
     ~Executor();
 
@@ -45,13 +184,73 @@ class Executor
     // Execute with the given interface functions
     void operator()(QuantumInterface& qi, RuntimeInterface& ri) const;
 
+    // Execute many shots in a compiled loop
+    void run_shots(QuantumInterface& qi,
+                   RuntimeInterface& ri,
+                   size_type num_shots,
+                   ShotCallback const& on_shot) const;
+
+    // Execute while recording the QIR calls, returning whether replayable
+    bool
+    record(QuantumInterface& qi, RuntimeInterface& ri, GateTape* tape) const;
+
+    // Repeat a recorded execution without running the compiled program
+    void replay(GateTape const& tape,
+                QuantumInterface& qi,
+                RuntimeInterface& ri) const;
+
+    // Repeat a recorded execution on a different number of qubits
+    void replay(GateTape const& tape,
+                size_type num_qubits,
+                QuantumInterface& qi,
+                RuntimeInterface& ri) const;
+
+    //! Whether every execution makes the same sequence of QIR calls
+    bool shot_invariant() const { return shot_invariant_; }
+
+    //! Whether measurement outcomes affect the circuit
+    ExecutionClass execution_class() const { return execution_class_; }
+
+    //! Attributes of the entry point used to set up the quantum interface
+    EntryPointAttrs const& entry_point_attrs() const
+    {
+        return entry_point_attrs_;
+    }
+
+    // Get compilation statistics
+    ExecutorStats stats() const;
+
   private:
-    llvm::Function* entrypoint_{nullptr};
-    llvm::Module* module_{nullptr};
+    //// TYPES ////
+
+    using EntryFunction = void (*)();
+    using LoopFunction = void (*)(size_type);
+
+    //// DATA ////
 
     EntryPointAttrs entry_point_attrs_;
     ModuleFlags module_flags_;
+    std::unique_ptr<llvm::orc::ThreadSafeContext> context_;
+    std::unique_ptr<detail::DiskObjectCache> cache_;
     std::unique_ptr<llvm::ExecutionEngine> ee_;
+    std::unique_ptr<llvm::orc::LLJIT> jit_;
+    EntryFunction entry_{nullptr};
+    LoopFunction loop_{nullptr};
+    OptimizationStats opt_stats_;
+    size_type num_unloaded_{0};
+    size_type num_static_results_{0};
+    bool shot_invariant_{false};
+    bool buffer_gates_{false};
+    ExecutionClass execution_class_{ExecutionClass::dynamic_circuit};
+
+    //// HELPER FUNCTIONS ////
+
+    void begin_buffering() const;
+
+    void build_mcjit(Module&& module, FunctionOverrides const& overrides);
+    void build_orc(Module&& module,
+                   FunctionOverrides const& overrides,
+                   bool lazy);
 };
 
 //---------------------------------------------------------------------------//
@@ -0,0 +1,591 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/GateTape.cc
+//---------------------------------------------------------------------------//
+#include "GateTape.hh"
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_set>
+#include <vector>
+
+#include "Assert.hh"
+#include "QuantumInterface.hh"
+#include "RuntimeInterface.hh"
+#include "detail/Lightcone.hh"
+
+namespace qiree
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Get the range of integer operands that are qubits.
+ *
+ * The result is false if the operation acts on qubits passed in an array,
+ * which are not known from the tape.
+ */
+bool qubit_ids(GateOpCode code, size_type* begin, size_type* end)
+{
+    using GOC = GateOpCode;
+    *begin = 0;
+    *end = 0;
+    switch (code)
+    {
+        case GOC::mz:
+            *end = 1;
+            return true;
+        case GOC::r_adj:
+        case GOC::r:
+            // Pauli basis precedes the qubit
+            *begin = 1;
+            *end = 2;
+            return true;
+        case GOC::exp_adj:
+        case GOC::exp:
+        case GOC::exp_ctl:
+        case GOC::exp_ctladj:
+        case GOC::h_ctl:
+        case GOC::r_ctl:
+        case GOC::r_ctladj:
+        case GOC::rx_ctl:
+        case GOC::ry_ctl:
+        case GOC::rz_ctl:
+        case GOC::s_ctl:
+        case GOC::s_ctladj:
+        case GOC::t_ctl:
+        case GOC::t_ctladj:
+        case GOC::x_ctl:
+        case GOC::y_ctl:
+        case GOC::z_ctl:
+        case GOC::assertmeasurementprobability:
+        case GOC::assertmeasurementprobability_ctl:
+            return false;
+        default:
+            if (!is_runtime(code))
+            {
+                *end = num_ids(code);
+            }
+            return true;
+    }
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get a string corresponding to an operation.
+ */
+char const* to_cstring(GateOpCode value)
+{
+    static char const* const strings[] = {
+        "mz",
+        "ccx",
+        "cnot",
+        "cx",
+        "cy",
+        "cz",
+        "exp_adj",
+        "exp",
+        "exp_ctl",
+        "exp_ctladj",
+        "h",
+        "h_ctl",
+        "r_adj",
+        "r",
+        "r_ctl",
+        "r_ctladj",
+        "reset",
+        "rx",
+        "rx_ctl",
+        "rxx",
+        "ry",
+        "ry_ctl",
+        "ryy",
+        "rz",
+        "rz_ctl",
+        "rzz",
+        "s_adj",
+        "s",
+        "s_ctl",
+        "s_ctladj",
+        "swap",
+        "t_adj",
+        "t",
+        "t_ctl",
+        "t_ctladj",
+        "x",
+        "x_ctl",
+        "y",
+        "y_ctl",
+        "z",
+        "z_ctl",
+        "assertmeasurementprobability",
+        "assertmeasurementprobability_ctl",
+        "initialize",
+        "array_record_output",
+        "tuple_record_output",
+        "result_record_output",
+        "constant_record_output",
+    };
+    static_assert(std::size(strings)
+                  == static_cast<std::size_t>(GateOpCode::size_));
+    QIREE_EXPECT(value < GateOpCode::size_);
+    return strings[static_cast<std::size_t>(value)];
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Number of integer operands used by an operation.
+ *
+ * Runtime operations have an extra hidden operand referencing their tag.
+ */
+size_type num_ids(GateOpCode value)
+{
+    switch (value)
+    {
+        case GateOpCode::initialize:
+            return 0;
+        case GateOpCode::h:
+        case GateOpCode::reset:
+        case GateOpCode::rx:
+        case GateOpCode::ry:
+        case GateOpCode::rz:
+        case GateOpCode::s_adj:
+        case GateOpCode::s:
+        case GateOpCode::t_adj:
+        case GateOpCode::t:
+        case GateOpCode::x:
+        case GateOpCode::y:
+        case GateOpCode::z:
+        case GateOpCode::array_record_output:
+        case GateOpCode::tuple_record_output:
+        case GateOpCode::result_record_output:
+        case GateOpCode::constant_record_output:
+            return 1;
+        case GateOpCode::ccx:
+            return 3;
+        case GateOpCode::assertmeasurementprobability:
+            return 4;
+        case GateOpCode::size_:
+            QIREE_ASSERT_UNREACHABLE();
+        default:
+            return 2;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Number of real parameters used by an operation.
+ */
+size_type num_params(GateOpCode value)
+{
+    switch (value)
+    {
+        case GateOpCode::exp_adj:
+        case GateOpCode::exp:
+        case GateOpCode::r_adj:
+        case GateOpCode::r:
+        case GateOpCode::rx:
+        case GateOpCode::rxx:
+        case GateOpCode::ry:
+        case GateOpCode::ryy:
+        case GateOpCode::rz:
+        case GateOpCode::rzz:
+            return 1;
+        case GateOpCode::assertmeasurementprobability:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Append an operation.
+ */
+void GateTape::push_back(GateOp const& op)
+{
+    QIREE_EXPECT(op.code < GateOpCode::size_);
+
+    codes_.push_back(op.code);
+
+    size_type const n_ids = num_ids(op.code);
+    id_offsets_.push_back(ids_.size());
+    ids_.insert(ids_.end(), op.ids.begin(), op.ids.begin() + n_ids);
+    if (is_runtime(op.code))
+    {
+        ids_.push_back(tags_.size());
+        tags_.push_back(op.tag);
+    }
+
+    size_type const n_params = num_params(op.code);
+    size_type const param_offset = params_.allocate(n_params);
+    param_offsets_.push_back(param_offset);
+    std::copy(op.params.begin(),
+              op.params.begin() + n_params,
+              params_.data(param_offset));
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Remove all operations but keep the allocated storage.
+ */
+void GateTape::clear()
+{
+    codes_.clear();
+    id_offsets_.clear();
+    param_offsets_.clear();
+    ids_.clear();
+    params_.clear();
+    tags_.clear();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Reserve space for a number of operations.
+ *
+ * Most gates have one or two qubit operands, so the operand array reserves
+ * two per operation.
+ */
+void GateTape::reserve(size_type num_ops)
+{
+    codes_.reserve(num_ops);
+    id_offsets_.reserve(num_ops);
+    param_offsets_.reserve(num_ops);
+    ids_.reserve(2 * num_ops);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Unpack an operation.
+ */
+GateOp GateTape::operator[](size_type i) const
+{
+    QIREE_EXPECT(i < this->size());
+
+    GateOp result;
+    result.code = codes_[i];
+    size_type const* id = this->ids(i);
+    std::copy(id, id + num_ids(result.code), result.ids.begin());
+    double const* p = this->params(i);
+    std::copy(p, p + num_params(result.code), result.params.begin());
+    result.tag = this->tag(i);
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Output label of a runtime operation.
+ *
+ * The result is null for gates.
+ */
+OptionalCString GateTape::tag(size_type i) const
+{
+    QIREE_EXPECT(i < this->size());
+
+    GateOpCode const code = codes_[i];
+    if (!is_runtime(code))
+    {
+        return nullptr;
+    }
+    return tags_[this->ids(i)[num_ids(code)]];
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Call the interface functions for every operation in a tape.
+ *
+ * Consecutive gates and measurements are sent to the quantum interface as a
+ * single block with \c QuantumInterface::apply . This does not call
+ * \c set_up or \c tear_down on the quantum interface.
+ */
+void replay(GateTape const& tape, QuantumInterface& qi, RuntimeInterface& ri)
+{
+    // Storage is kept between replays to avoid reallocating
+    static thread_local std::vector<GateOp> block;
+    auto apply_block = [&qi] {
+        if (!block.empty())
+        {
+            qi.apply(block);
+            block.clear();
+        }
+    };
+
+    for (size_type i = 0, size = tape.size(); i < size; ++i)
+    {
+        GateOpCode const code = tape.code(i);
+        if (!is_runtime(code))
+        {
+            block.push_back(tape[i]);
+            continue;
+        }
+
+        apply_block();
+        size_type const* id = tape.ids(i);
+        switch (code)
+        {
+            case GateOpCode::initialize:
+                ri.initialize(tape.tag(i));
+                break;
+            case GateOpCode::array_record_output:
+                ri.array_record_output(id[0], tape.tag(i));
+                break;
+            case GateOpCode::tuple_record_output:
+                ri.tuple_record_output(id[0], tape.tag(i));
+                break;
+            case GateOpCode::result_record_output:
+                ri.result_record_output(Result{id[0]}, tape.tag(i));
+                break;
+            case GateOpCode::constant_record_output:
+                ri.constant_record_output(static_cast<QState>(id[0]),
+                                          tape.tag(i));
+                break;
+            default:
+                QIREE_ASSERT_UNREACHABLE();
+        }
+    }
+    apply_block();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Reuse the indices of retired qubits, returning the number of qubits used.
+ *
+ * A qubit is retired after its last operation if that operation is a
+ * measurement or reset. The operations are copied to the output tape with
+ * each qubit renumbered at its first use: a retired index is reused if
+ * available (preferring reset qubits, which are already in the zero state),
+ * and otherwise a new index is created. Since a measured qubit may be in the
+ * one state, a \c reset is inserted before its index is reused.
+ *
+ * The returned number of qubits is the peak number of simultaneously live
+ * qubits, which is sufficient to replay the compacted tape. If the tape acts
+ * on qubits in arrays (e.g., controlled gates), the result is zero and the
+ * output tape is unchanged.
+ */
+size_type compact_qubits(GateTape const& tape, GateTape* compacted)
+{
+    QIREE_EXPECT(compacted);
+    constexpr size_type unassigned = static_cast<size_type>(-1);
+
+    // Find the last operation on each qubit
+    std::vector<size_type> last_use;
+    for (size_type i = 0; i < tape.size(); ++i)
+    {
+        size_type begin, end;
+        if (!qubit_ids(tape.code(i), &begin, &end))
+        {
+            return 0;
+        }
+        size_type const* id = tape.ids(i);
+        for (size_type j = begin; j < end; ++j)
+        {
+            if (id[j] >= last_use.size())
+            {
+                last_use.resize(id[j] + 1, unassigned);
+            }
+            last_use[id[j]] = i;
+        }
+    }
+
+    std::vector<size_type> physical(last_use.size(), unassigned);
+    std::vector<size_type> zeroed;
+    std::vector<size_type> measured;
+    size_type num_qubits = 0;
+
+    compacted->clear();
+    compacted->reserve(tape.size());
+    for (size_type i = 0; i < tape.size(); ++i)
+    {
+        GateOp op = tape[i];
+        size_type begin, end;
+        qubit_ids(op.code, &begin, &end);
+        for (size_type j = begin; j < end; ++j)
+        {
+            size_type& q = physical[op.ids[j]];
+            if (q == unassigned)
+            {
+                if (!zeroed.empty())
+                {
+                    q = zeroed.back();
+                    zeroed.pop_back();
+                }
+                else if (!measured.empty())
+                {
+                    q = measured.back();
+                    measured.pop_back();
+                    if (op.code != GateOpCode::reset)
+                    {
+                        GateOp reset;
+                        reset.code = GateOpCode::reset;
+                        reset.ids[0] = q;
+                        compacted->push_back(reset);
+                    }
+                }
+                else
+                {
+                    q = num_qubits++;
+                }
+            }
+            op.ids[j] = q;
+        }
+        compacted->push_back(op);
+
+        if ((op.code == GateOpCode::mz || op.code == GateOpCode::reset)
+            && last_use[tape.ids(i)[0]] == i)
+        {
+            // Retire the qubit
+            (op.code == GateOpCode::reset ? zeroed : measured)
+                .push_back(op.ids[0]);
+        }
+    }
+    return num_qubits;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Copy the operations that can affect recorded results.
+ *
+ * The tape is traversed backward from its \c result_record_output
+ * operations, and gates, measurements, and resets outside the causal
+ * lightcone of the recorded results are omitted from the output. Runtime
+ * operations are always kept. Every operation preceding one on qubits in an
+ * array is kept.
+ *
+ * \return Number of omitted operations
+ */
+size_type prune_lightcone(GateTape const& tape, GateTape* pruned)
+{
+    QIREE_EXPECT(pruned);
+
+    detail::Lightcone lightcone;
+    std::vector<bool> keep(tape.size());
+    for (size_type i = tape.size(); i-- > 0;)
+    {
+        GateOpCode const code = tape.code(i);
+        size_type const* id = tape.ids(i);
+        size_type begin, end;
+        if (code == GateOpCode::result_record_output)
+        {
+            lightcone.record(id[0]);
+            keep[i] = true;
+        }
+        else if (is_runtime(code))
+        {
+            keep[i] = true;
+        }
+        else if (!qubit_ids(code, &begin, &end))
+        {
+            lightcone.barrier();
+            keep[i] = true;
+        }
+        else if (code == GateOpCode::mz)
+        {
+            keep[i] = lightcone.measure(id[0], id[1]);
+        }
+        else if (code == GateOpCode::reset)
+        {
+            keep[i] = lightcone.reset(id[0]);
+        }
+        else
+        {
+            keep[i] = lightcone.gate(id + begin, id + end);
+        }
+    }
+
+    pruned->clear();
+    size_type num_pruned = 0;
+    for (size_type i = 0; i < tape.size(); ++i)
+    {
+        if (keep[i])
+        {
+            pruned->push_back(tape[i]);
+        }
+        else
+        {
+            ++num_pruned;
+        }
+    }
+    return num_pruned;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Separate the gates of a tape from its terminal measurements.
+ *
+ * A measurement is terminal if no later operation acts on its qubit. If all
+ * measurements are terminal, the state before them can be simulated once and
+ * sampled for every shot: the gates are copied to \c gates and the
+ * measurements and runtime operations to \c outputs , each in their original
+ * order.
+ *
+ * The tape cannot be split (and the result is false) if it resets a qubit,
+ * measures a qubit or into a result more than once, records a result before
+ * it is measured, or acts on qubits in an array.
+ */
+bool split_terminal_measurements(GateTape const& tape,
+                                 GateTape* gates,
+                                 GateTape* outputs)
+{
+    QIREE_EXPECT(gates && outputs);
+    gates->clear();
+    outputs->clear();
+
+    std::vector<bool> measured;
+    std::unordered_set<size_type> results;
+    auto is_measured = [&measured](size_type q) {
+        return q < measured.size() && measured[q];
+    };
+
+    for (size_type i = 0; i < tape.size(); ++i)
+    {
+        GateOpCode const code = tape.code(i);
+        size_type const* id = tape.ids(i);
+        size_type begin, end;
+        if (code == GateOpCode::result_record_output && !results.count(id[0]))
+        {
+            return false;
+        }
+        if (is_runtime(code))
+        {
+            outputs->push_back(tape[i]);
+            continue;
+        }
+        if (code == GateOpCode::reset || !qubit_ids(code, &begin, &end))
+        {
+            return false;
+        }
+        for (size_type j = begin; j < end; ++j)
+        {
+            if (is_measured(id[j]))
+            {
+                return false;
+            }
+        }
+        if (code != GateOpCode::mz)
+        {
+            gates->push_back(tape[i]);
+            continue;
+        }
+
+        if (!results.insert(id[1]).second)
+        {
+            return false;
+        }
+        if (id[0] >= measured.size())
+        {
+            measured.resize(id[0] + 1);
+        }
+        measured[id[0]] = true;
+        outputs->push_back(tape[i]);
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
@@ -0,0 +1,204 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/GateTape.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Types.hh"
+#include "detail/BlockArena.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+class QuantumInterface;
+class RuntimeInterface;
+
+//---------------------------------------------------------------------------//
+/*!
+ * QIR call that can be recorded and replayed.
+ *
+ * Instructions that return a value to the program (\c m, \c measure, \c
+ * mresetz, \c read_result) cannot be replayed and are absent. Recording a
+ * constant result stores its value in place of the result handle.
+ */
+enum class GateOpCode : std::uint8_t
+{
+    // Measurements
+    mz,
+    // Gates
+    ccx,
+    cnot,
+    cx,
+    cy,
+    cz,
+    exp_adj,
+    exp,
+    exp_ctl,
+    exp_ctladj,
+    h,
+    h_ctl,
+    r_adj,
+    r,
+    r_ctl,
+    r_ctladj,
+    reset,
+    rx,
+    rx_ctl,
+    rxx,
+    ry,
+    ry_ctl,
+    ryy,
+    rz,
+    rz_ctl,
+    rzz,
+    s_adj,
+    s,
+    s_ctl,
+    s_ctladj,
+    swap,
+    t_adj,
+    t,
+    t_ctl,
+    t_ctladj,
+    x,
+    x_ctl,
+    y,
+    y_ctl,
+    z,
+    z_ctl,
+    // Assertions
+    assertmeasurementprobability,
+    assertmeasurementprobability_ctl,
+    // Runtime
+    initialize,
+    array_record_output,
+    tuple_record_output,
+    result_record_output,
+    constant_record_output,  //!< Value of a constant result
+    size_
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * A single recorded QIR call.
+ *
+ * Opaque identifiers (qubits, results, arrays, tuples, strings), record
+ * sizes, and Pauli bases are stored as integers in the order they appear in
+ * the call; angles and probabilities are stored as parameters. The number of
+ * each used by an operation is given by \c num_ids and \c num_params .
+ */
+struct GateOp
+{
+    GateOpCode code{GateOpCode::size_};
+    std::array<size_type, 4> ids{};
+    std::array<double, 2> params{};
+    OptionalCString tag{nullptr};
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Sequence of QIR calls recorded from one execution of a program.
+ *
+ * The tape is stored as a structure of arrays: a compact array of opcodes,
+ * a flat array of integer operands, and an arena of real parameters. Each
+ * operation only stores as many operands and parameters as its opcode uses,
+ * and appending never allocates once a cleared tape has been refilled to its
+ * previous size. Operations can be read in place through \c code , \c ids ,
+ * \c params , and \c tag , or unpacked into a \c GateOp .
+ */
+class GateTape
+{
+  public:
+    // Append an operation
+    void push_back(GateOp const& op);
+
+    // Remove all operations but keep the allocated storage
+    void clear();
+
+    // Reserve space for a number of operations
+    void reserve(size_type num_ops);
+
+    //! Number of operations
+    size_type size() const { return codes_.size(); }
+
+    //! Whether no operations have been recorded
+    bool empty() const { return codes_.empty(); }
+
+    // Unpack an operation
+    GateOp operator[](size_type i) const;
+
+    //!@{
+    //! \name Operation data
+
+    //! Opcode of an operation
+    GateOpCode code(size_type i) const { return codes_[i]; }
+
+    //! Integer operands of an operation
+    size_type const* ids(size_type i) const
+    {
+        return ids_.data() + id_offsets_[i];
+    }
+
+    //! Real parameters of an operation
+    double const* params(size_type i) const
+    {
+        return params_.data(param_offsets_[i]);
+    }
+
+    // Output label of a runtime operation
+    OptionalCString tag(size_type i) const;
+
+    //! All opcodes
+    std::vector<GateOpCode> const& codes() const { return codes_; }
+    //!@}
+
+  private:
+    std::vector<GateOpCode> codes_;
+    std::vector<size_type> id_offsets_;
+    std::vector<size_type> param_offsets_;
+    std::vector<size_type> ids_;
+    detail::BlockArena<double> params_;
+    std::vector<OptionalCString> tags_;
+};
+
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+// Get a string corresponding to an operation
+char const* to_cstring(GateOpCode value);
+
+// Number of integer operands used by an operation
+size_type num_ids(GateOpCode value);
+
+// Number of real parameters used by an operation
+size_type num_params(GateOpCode value);
+
+//! Whether an operation is a call to the runtime interface
+inline constexpr bool is_runtime(GateOpCode value)
+{
+    return value >= GateOpCode::initialize && value < GateOpCode::size_;
+}
+
+// Call the interface functions for every operation in a tape
+void replay(GateTape const& tape, QuantumInterface& qi, RuntimeInterface& ri);
+
+// Reuse the indices of retired qubits, returning the number of qubits used
+size_type compact_qubits(GateTape const& tape, GateTape* compacted);
+
+// Copy the operations that can affect recorded results
+size_type prune_lightcone(GateTape const& tape, GateTape* pruned);
+
+// Separate the gates of a tape from its terminal measurements
+bool split_terminal_measurements(GateTape const& tape,
+                                 GateTape* gates,
+                                 GateTape* outputs);
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
@@ -8,17 +8,27 @@
 #include "Module.hh"
 
 #include <memory>
+#include <optional>
 #include <sstream>
+#include <string>
 #include <string_view>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/IR/Attributes.h>
 #include <llvm/IR/Constants.h>
+#include <llvm/IR/DiagnosticHandler.h>
+#include <llvm/IR/DiagnosticInfo.h>
+#include <llvm/IR/DiagnosticPrinter.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IRReader/IRReader.h>
+#include <llvm/Linker/Linker.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/SourceMgr.h>
 
 #include "Assert.hh"
+#include "detail/Materialize.hh"
+#include "detail/MeasurementFlow.hh"
 
 using namespace std::string_view_literals;
 
@@ -28,33 +38,109 @@ namespace
 {
 //---------------------------------------------------------------------------//
 /*!
- * Shared, thread-local LLVM context.
+ * Create a new LLVM context with a lock for JIT compilation.
  *
- * This must exceed the lifetime of any IR, modules, etc.
+ * Each module gets its own context so that identically named types in
+ * separately loaded modules are not renamed, and so that modules can be
+ * loaded and compiled independently.
  */
-llvm::LLVMContext& context()
+std::unique_ptr<llvm::orc::ThreadSafeContext> make_context()
 {
-    static llvm::LLVMContext ctx;
-    return ctx;
+    return std::make_unique<llvm::orc::ThreadSafeContext>(
+        std::make_unique<llvm::LLVMContext>());
 }
 
 //---------------------------------------------------------------------------//
 /*!
- * Load an LLVM module from a file.
+ * Parse an LLVM module from a buffer.
+ *
+ * The buffer is only needed during parsing. Textual IR must be followed by a
+ * null character (not included in the buffer), which the LLVM lexer uses to
+ * detect the end of input.
  */
-std::unique_ptr<llvm::Module> load_llvm_module(std::string const& filename)
+std::unique_ptr<llvm::Module> parse_llvm_module(llvm::MemoryBufferRef buffer,
+                                                llvm::LLVMContext& context)
 {
     llvm::SMDiagnostic err;
-    auto module = llvm::parseIRFile(filename, err, context());
+    auto module = llvm::parseIR(buffer, err, context);
     if (!module)
     {
         err.print("qiree", llvm::errs());
         QIREE_VALIDATE(module,
-                       << "failed to read QIR input at '" << filename << "'");
+                       << "failed to read QIR input from '"
+                       << std::string_view(buffer.getBufferIdentifier())
+                       << "' (" << buffer.getBufferSize() << " bytes)");
     }
     return module;
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * Parse an LLVM module from in-memory IR (bitcode or disassembled).
+ *
+ * The content is parsed in place without copying if it is bitcode, or if it
+ * is textual IR whose last byte is a null terminator. Otherwise textual IR is
+ * copied once so that it can be null terminated for the parser.
+ */
+std::unique_ptr<llvm::Module>
+parse_llvm_bytes(std::string_view content, llvm::LLVMContext& context)
+{
+    llvm::StringRef data{content.data(), content.size()};
+    llvm::StringRef const name{"<in-memory>"};
+    llvm::MemoryBufferRef buffer{data, name};
+    std::unique_ptr<llvm::MemoryBuffer> copy;
+    if (!llvm::isBitcode(data.bytes_begin(), data.bytes_end()))
+    {
+        if (!data.empty() && data.back() == '\0')
+        {
+            // Exclude the terminator from the parsed text
+            buffer = llvm::MemoryBufferRef{data.drop_back(), name};
+        }
+        else
+        {
+            copy = llvm::MemoryBuffer::getMemBufferCopy(data, name);
+            buffer = copy->getMemBufferRef();
+        }
+    }
+    return parse_llvm_module(buffer, context);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Load an LLVM module from a file.
+ *
+ * Large files are memory mapped rather than read into a heap allocation.
+ * Bitcode is loaded lazily: the module takes ownership of the buffer, and
+ * function bodies are only read when the executor materializes them. Queries
+ * of the entry point attributes and module flags never read a body.
+ */
+std::unique_ptr<llvm::Module>
+load_llvm_module(std::string const& filename, llvm::LLVMContext& context)
+{
+    auto buffer = llvm::MemoryBuffer::getFileOrSTDIN(
+        filename, /* IsText = */ false, /* RequiresNullTerminator = */ true);
+    QIREE_VALIDATE(buffer,
+                   << "failed to read QIR input at '" << filename
+                   << "': " << buffer.getError().message());
+
+    llvm::StringRef data = (*buffer)->getBuffer();
+    if (!llvm::isBitcode(data.bytes_begin(), data.bytes_end()))
+    {
+        return parse_llvm_module((*buffer)->getMemBufferRef(), context);
+    }
+
+    auto size = (*buffer)->getBufferSize();
+    auto module = llvm::getOwningLazyBitcodeModule(std::move(*buffer), context);
+    if (!module)
+    {
+        QIREE_VALIDATE(false,
+                       << "failed to read QIR bitcode from '" << filename
+                       << "' (" << size
+                       << " bytes): " << llvm::toString(module.takeError()));
+    }
+    return std::move(*module);
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * Find a function tagged with the QIR `entry_point`.
@@ -96,23 +182,53 @@ void attr_get_to(llvm::Attribute const& attr, T& dest)
                    << std::string_view(attr.getKindAsString()) << "'");
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * Save linker errors instead of aborting.
+ */
+class LinkDiagnosticHandler final : public llvm::DiagnosticHandler
+{
+  public:
+    explicit LinkDiagnosticHandler(std::string* errors) : errors_{errors} {}
+
+    bool handleDiagnostics(llvm::DiagnosticInfo const& info) final
+    {
+        if (info.getSeverity() != llvm::DS_Error)
+        {
+            // Print warnings with the default handler
+            return false;
+        }
+        llvm::raw_string_ostream os{*errors_};
+        if (!errors_->empty())
+        {
+            os << "; ";
+        }
+        llvm::DiagnosticPrinterRawOStream printer{os};
+        info.print(printer);
+        return true;
+    }
+
+  private:
+    std::string* errors_;
+};
+
 //---------------------------------------------------------------------------//
 }  // namespace
 
 //---------------------------------------------------------------------------//
 /*!
  * Construct with an LLVM module.
+ *
+ * The module's context must outlive any executor built from it and must not
+ * be used by other threads while the executor compiles. Pass the context to
+ * the constructor if it is shared with other threads. Because the context is
+ * not owned by a \c ThreadSafeContext , executors compile the module with
+ * MCJIT regardless of the requested engine.
  */
 Module::Module(UPModule&& module) : module_{std::move(module)}
 {
     QIREE_EXPECT(module_);
-
-    // Search for entry point
-    entrypoint_ = find_entry_point(*module_);
-    QIREE_VALIDATE(entrypoint_,
-                   << "no function with QIR 'entry_point' attribute "
-                      "exists in '"
-                   << module_->getSourceFileName() << "'");
+    this->find_entry_point();
 }
 
 //---------------------------------------------------------------------------//
@@ -125,20 +241,35 @@ Module::Module(UPModule&& module, std::string const& entrypoint)
     : module_{std::move(module)}
 {
     QIREE_EXPECT(module_);
+    this->find_entry_point(entrypoint);
+}
 
-    // Search for explicitly named entry point
-    entrypoint_ = module_->getFunction(entrypoint);
-    QIREE_VALIDATE(entrypoint_,
-                   << "no entrypoint function '" << entrypoint << "' exists");
+//---------------------------------------------------------------------------//
+/*!
+ * Construct from an external LLVM module in a shared context.
+ *
+ * The context's lock is held whenever QIR-EE reads, compiles, or destroys the
+ * module, so other modules in the same context can safely be used by other
+ * threads that also hold the lock.
+ */
+Module::Module(UPModule&& module, llvm::orc::ThreadSafeContext const& context)
+    : context_{std::make_unique<llvm::orc::ThreadSafeContext>(context)}
+{
+    QIREE_EXPECT(module);
+    QIREE_EXPECT(&module->getContext() == context.getContext());
+    auto lock = context_->getLock();
+    module_ = std::move(module);
+    this->find_entry_point();
 }
 
 //---------------------------------------------------------------------------//
 /*!
  * Construct with an LLVM IR file (bitcode or disassembled).
  */
-Module::Module(std::string const& filename)
-    : Module{load_llvm_module(filename)}
+Module::Module(std::string const& filename) : context_{make_context()}
 {
+    module_ = load_llvm_module(filename, *context_->getContext());
+    this->find_entry_point();
 }
 
 //---------------------------------------------------------------------------//
@@ -147,50 +278,145 @@ Module::Module(std::string const& filename)
  * Useful when there are multiple entry points.
  */
 Module::Module(std::string const& filename, std::string const& entrypoint)
-    : module_{load_llvm_module(filename)}
+    : context_{make_context()}
 {
-    QIREE_EXPECT(module_);
+    module_ = load_llvm_module(filename, *context_->getContext());
+    this->find_entry_point(entrypoint);
+}
 
-    // Search for explicitly named entry point
-    entrypoint_ = module_->getFunction(entrypoint);
-    QIREE_VALIDATE(entrypoint_,
-                   << "no entrypoint function '" << entrypoint << "' exists");
+//---------------------------------------------------------------------------//
+/*!
+ * Read a module from in-memory LLVM IR (bitcode or disassembled).
+ *
+ * The content is parsed in place without copying if it is bitcode, or if it
+ * is textual IR whose last byte is a null terminator. Otherwise textual IR is
+ * copied once so that it can be null terminated for the parser.
+ */
+std::unique_ptr<Module> Module::from_bytes(std::string_view content)
+{
+    auto result = std::make_unique<Module>();
+    result->context_ = make_context();
+
+    // Save the parsed llvm::Module and search for the entry point
+    result->module_
+        = parse_llvm_bytes(content, *result->context_->getContext());
+    result->find_entry_point();
+    return result;
 }
 
+//! Construct in an empty state
+Module::Module() = default;
+
 //---------------------------------------------------------------------------//
 /*!
- * Read a module by parsing an in-memory LLVM IR string.
+ * Destroy the module while holding its context's lock.
  */
-std::unique_ptr<Module> Module::from_bytes(std::string const& content)
+Module::~Module()
 {
-    llvm::SMDiagnostic err;
+    this->reset();
+}
 
-    // Create memory buffer from the in-memory IR content
-    std::unique_ptr<llvm::MemoryBuffer> buffer
-        = llvm::MemoryBuffer::getMemBuffer(content, "<in-memory>", false);
+//---------------------------------------------------------------------------//
+//! Default move construction
+Module::Module(Module&&) = default;
 
-    // Parse the IR using LLVM context
-    auto llvm_module = llvm::parseIR(buffer->getMemBufferRef(), err, context());
+//---------------------------------------------------------------------------//
+/*!
+ * Move assign, destroying the old module before its context.
+ */
+Module& Module::operator=(Module&& other)
+{
+    this->reset();
+    context_ = std::move(other.context_);
+    module_ = std::move(other.module_);
+    entrypoint_ = other.entrypoint_;
+    num_linked_ = other.num_linked_;
+    return *this;
+}
 
-    if (!llvm_module)
+//---------------------------------------------------------------------------//
+/*!
+ * Link a library from an LLVM IR file (bitcode or disassembled).
+ *
+ * Library definitions replace the program's declarations of the same name,
+ * and libraries may call functions defined in previously linked ones. It is
+ * an error for a library to redefine an existing function.
+ */
+void Module::link(std::string const& filename)
+{
+    QIREE_EXPECT(*this);
+    std::optional<llvm::orc::ThreadSafeContext::Lock> context_lock;
+    if (context_)
     {
-        err.print("qiree", llvm::errs());
-        QIREE_VALIDATE(llvm_module,
-                       << "Failed to parse QIR from in-memory content '"
-                       << content << "'");
+        context_lock.emplace(context_->getLock());
     }
+    this->link_module(load_llvm_module(filename, module_->getContext()));
+}
 
-    // Construct and return Module from parsed llvm::Module
-    return std::make_unique<Module>(std::move(llvm_module));
+//---------------------------------------------------------------------------//
+/*!
+ * Link a library from in-memory LLVM IR (bitcode or disassembled).
+ */
+void Module::link_bytes(std::string_view content)
+{
+    QIREE_EXPECT(*this);
+    std::optional<llvm::orc::ThreadSafeContext::Lock> context_lock;
+    if (context_)
+    {
+        context_lock.emplace(context_->getLock());
+    }
+    this->link_module(parse_llvm_bytes(content, module_->getContext()));
 }
 
-//! Construct in an empty state
-Module::Module() = default;
+//---------------------------------------------------------------------------//
+/*!
+ * Link a library in the same context while holding its lock.
+ *
+ * The program is fully loaded first since the linker may replace any of its
+ * declarations. Linker errors are reported through the context's diagnostic
+ * handler, which is temporarily replaced so that they can be thrown.
+ */
+void Module::link_module(UPModule&& library)
+{
+    QIREE_EXPECT(library && &library->getContext() == &module_->getContext());
 
-// Default destructor and move
-Module::~Module() = default;
-Module::Module(Module&&) = default;
-Module& Module::operator=(Module&&) = default;
+    if (llvm::Error err = module_->materializeAll())
+    {
+        QIREE_VALIDATE(false,
+                       << "failed to load QIR bitcode from '"
+                       << module_->getModuleIdentifier()
+                       << "': " << llvm::toString(std::move(err)));
+    }
+
+    std::string const name = library->getModuleIdentifier();
+    std::string errors;
+    llvm::LLVMContext& context = module_->getContext();
+    auto prev_handler = context.getDiagnosticHandler();
+    context.setDiagnosticHandler(
+        std::make_unique<LinkDiagnosticHandler>(&errors));
+    bool failed = llvm::Linker::linkModules(*module_, std::move(library));
+    context.setDiagnosticHandler(std::move(prev_handler));
+
+    QIREE_VALIDATE(!failed,
+                   << "failed to link QIR library '" << name
+                   << "': " << errors);
+    ++num_linked_;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Destroy the module, locking its context if it may be shared.
+ */
+void Module::reset()
+{
+    entrypoint_ = nullptr;
+    if (module_ && context_)
+    {
+        auto lock = context_->getLock();
+        module_.reset();
+    }
+    module_.reset();
+}
 
 //---------------------------------------------------------------------------//
 /*!
@@ -266,5 +492,72 @@ ModuleFlags Module::load_module_flags() const
     return flags;
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * Determine whether measurement outcomes affect the circuit.
+ *
+ * A program is a dynamic circuit if the outcome of a measurement (from
+ * \c read_result , \c m , or \c mresetz ) can reach a branch condition or
+ * an argument of a quantum operation. Bitcode function bodies reachable from
+ * the entry point are loaded if needed.
+ */
+ExecutionClass Module::execution_class() const
+{
+    QIREE_EXPECT(*this);
+
+    std::optional<llvm::orc::ThreadSafeContext::Lock> context_lock;
+    if (context_)
+    {
+        context_lock.emplace(context_->getLock());
+    }
+    detail::load_reachable(*entrypoint_);
+
+    auto uses = detail::find_measurement_uses(*entrypoint_);
+    return uses.branch || uses.gate_argument ? ExecutionClass::dynamic_circuit
+                                             : ExecutionClass::static_circuit;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Search for the function with the QIR entry point attribute.
+ */
+void Module::find_entry_point()
+{
+    entrypoint_ = ::qiree::find_entry_point(*module_);
+    QIREE_VALIDATE(entrypoint_,
+                   << "no function with QIR 'entry_point' attribute "
+                      "exists in '"
+                   << module_->getSourceFileName() << "'");
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Search for an explicitly named entry point.
+ */
+void Module::find_entry_point(std::string const& name)
+{
+    entrypoint_ = module_->getFunction(name);
+    QIREE_VALIDATE(entrypoint_,
+                   << "no entrypoint function '" << name << "' exists");
+}
+
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Get a string corresponding to an execution class.
+ */
+char const* to_cstring(ExecutionClass value)
+{
+    switch (value)
+    {
+        case ExecutionClass::static_circuit:
+            return "static";
+        case ExecutionClass::dynamic_circuit:
+            return "dynamic";
+    }
+    return "";
+}
+
 //---------------------------------------------------------------------------//
 }  // namespace qiree
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "Types.hh"
 
@@ -16,6 +17,10 @@ namespace llvm
 {
 class Module;
 class Function;
+namespace orc
+{
+class ThreadSafeContext;
+}  // namespace orc
 }  // namespace llvm
 
 namespace qiree
@@ -23,6 +28,16 @@ namespace qiree
 //---------------------------------------------------------------------------//
 /*!
  * Load a QIR LLVM module.
+ *
+ * Subroutines defined in separate QIR libraries can be linked into the
+ * program before it is passed to an \c Executor , which then internalizes and
+ * inlines them so that classical optimizations apply across library calls.
+ *
+ * \code
+   Module m{"main.bc"};
+   m.link("subroutines.bc");
+   Executor execute{std::move(m)};
+ * \endcode
  */
 class Module
 {
@@ -33,8 +48,8 @@ class Module
     //!@}
 
   public:
-    // Reading a module by parsing an in-memory LLVM IR string.
-    static std::unique_ptr<Module> from_bytes(std::string const& content);
+    // Read a module from in-memory LLVM IR (bitcode or disassembled)
+    static std::unique_ptr<Module> from_bytes(std::string_view content);
 
     // Construct from an externally created LLVM module
     explicit Module(UPModule&& module);
@@ -48,6 +63,9 @@ class Module
     // Construct with an LLVM IR file (bitcode or disassembled) and entry point
     Module(std::string const& filename, std::string const& entrypoint);
 
+    // Construct from an external LLVM module in a shared context
+    Module(UPModule&& module, llvm::orc::ThreadSafeContext const& context);
+
     // Construct in an empty state
     Module();
 
@@ -60,6 +78,14 @@ class Module
     Module(Module const&) = delete;
     Module& operator=(Module const&) = delete;
 
+    //// LINKING ////
+
+    // Link a library from an LLVM IR file (bitcode or disassembled)
+    void link(std::string const& filename);
+
+    // Link a library from in-memory LLVM IR (bitcode or disassembled)
+    void link_bytes(std::string_view content);
+
     //// ACCESSORS ////
 
     // Process entry point attributes
@@ -68,16 +94,42 @@ class Module
     // Translate module attributes into flags
     ModuleFlags load_module_flags() const;
 
+    // Determine whether measurement outcomes affect the circuit
+    ExecutionClass execution_class() const;
+
+    //! Number of libraries linked into the module
+    size_type num_linked() const { return num_linked_; }
+
     //! True if the module has been constructed (and not moved)
     explicit operator bool() const { return static_cast<bool>(module_); }
 
   private:
+    // Context of the module, if known (must outlive module_)
+    std::unique_ptr<llvm::orc::ThreadSafeContext> context_;
     std::unique_ptr<llvm::Module> module_;
     llvm::Function* entrypoint_{nullptr};
+    size_type num_linked_{0};
+
+    // Search for the entry point
+    void find_entry_point();
+    void find_entry_point(std::string const& name);
+
+    // Link a library in the same context while holding its lock
+    void link_module(UPModule&& library);
+
+    // Destroy the module
+    void reset();
 
     // Make Executor a friend so it can take ownership of the pointer
     friend class Executor;
+    friend class CircuitAnalysis;
 };
 
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+// Get a string corresponding to an execution class
+char const* to_cstring(ExecutionClass value);
+
 //---------------------------------------------------------------------------//
 }  // namespace qiree
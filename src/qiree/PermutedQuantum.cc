@@ -0,0 +1,329 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/PermutedQuantum.cc
+//---------------------------------------------------------------------------//
+#include "PermutedQuantum.hh"
+
+#include <algorithm>
+#include <utility>
+
+#include "Assert.hh"
+#include "CircuitAnalysis.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with the target interface and the qubit permutation.
+ */
+PermutedQuantum::PermutedQuantum(QuantumInterface& target, VecIndex perm)
+    : target_{target}, perm_{std::move(perm)}
+{
+    QIREE_VALIDATE(
+        std::all_of(perm_.begin(),
+                    perm_.end(),
+                    [n = perm_.size()](size_type i) { return i < n; }),
+        << "qubit permutation has an out-of-range index");
+    VecIndex sorted = perm_;
+    std::sort(sorted.begin(), sorted.end());
+    QIREE_VALIDATE(
+        std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end(),
+        << "qubit permutation has a repeated index");
+}
+
+//---------------------------------------------------------------------------//
+// SETUP
+//---------------------------------------------------------------------------//
+void PermutedQuantum::set_up(EntryPointAttrs const& attrs)
+{
+    target_.set_up(attrs);
+}
+void PermutedQuantum::tear_down()
+{
+    target_.tear_down();
+}
+
+//---------------------------------------------------------------------------//
+// MEASUREMENTS
+//---------------------------------------------------------------------------//
+Result PermutedQuantum::m(Qubit arg1)
+{
+    return target_.m(this->map(arg1));
+}
+Result PermutedQuantum::measure(Array, Array)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+Result PermutedQuantum::mresetz(Qubit arg1)
+{
+    return target_.mresetz(this->map(arg1));
+}
+void PermutedQuantum::mz(Qubit arg1, Result arg2)
+{
+    target_.mz(this->map(arg1), arg2);
+}
+QState PermutedQuantum::read_result(Result arg1) const
+{
+    return target_.read_result(arg1);
+}
+
+//---------------------------------------------------------------------------//
+// GATES
+//---------------------------------------------------------------------------//
+void PermutedQuantum::ccx(Qubit arg1, Qubit arg2, Qubit arg3)
+{
+    target_.ccx(this->map(arg1), this->map(arg2), this->map(arg3));
+}
+void PermutedQuantum::cnot(Qubit arg1, Qubit arg2)
+{
+    target_.cnot(this->map(arg1), this->map(arg2));
+}
+void PermutedQuantum::cx(Qubit arg1, Qubit arg2)
+{
+    target_.cx(this->map(arg1), this->map(arg2));
+}
+void PermutedQuantum::cy(Qubit arg1, Qubit arg2)
+{
+    target_.cy(this->map(arg1), this->map(arg2));
+}
+void PermutedQuantum::cz(Qubit arg1, Qubit arg2)
+{
+    target_.cz(this->map(arg1), this->map(arg2));
+}
+void PermutedQuantum::exp_adj(Array, double, Array)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::exp(Array, double, Array)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::exp(Array, Tuple)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::exp_adj(Array, Tuple)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::h(Qubit arg1)
+{
+    target_.h(this->map(arg1));
+}
+void PermutedQuantum::h(Array, Qubit)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::r_adj(Pauli arg1, double arg2, Qubit arg3)
+{
+    target_.r_adj(arg1, arg2, this->map(arg3));
+}
+void PermutedQuantum::r(Pauli arg1, double arg2, Qubit arg3)
+{
+    target_.r(arg1, arg2, this->map(arg3));
+}
+void PermutedQuantum::r(Array, Tuple)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::r_adj(Array, Tuple)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::reset(Qubit arg1)
+{
+    target_.reset(this->map(arg1));
+}
+void PermutedQuantum::rx(double arg1, Qubit arg2)
+{
+    target_.rx(arg1, this->map(arg2));
+}
+void PermutedQuantum::rx(Array, Tuple)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::rxx(double arg1, Qubit arg2, Qubit arg3)
+{
+    target_.rxx(arg1, this->map(arg2), this->map(arg3));
+}
+void PermutedQuantum::ry(double arg1, Qubit arg2)
+{
+    target_.ry(arg1, this->map(arg2));
+}
+void PermutedQuantum::ry(Array, Tuple)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::ryy(double arg1, Qubit arg2, Qubit arg3)
+{
+    target_.ryy(arg1, this->map(arg2), this->map(arg3));
+}
+void PermutedQuantum::rz(double arg1, Qubit arg2)
+{
+    target_.rz(arg1, this->map(arg2));
+}
+void PermutedQuantum::rz(Array, Tuple)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::rzz(double arg1, Qubit arg2, Qubit arg3)
+{
+    target_.rzz(arg1, this->map(arg2), this->map(arg3));
+}
+void PermutedQuantum::s_adj(Qubit arg1)
+{
+    target_.s_adj(this->map(arg1));
+}
+void PermutedQuantum::s(Qubit arg1)
+{
+    target_.s(this->map(arg1));
+}
+void PermutedQuantum::s(Array, Qubit)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::s_adj(Array, Qubit)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::swap(Qubit arg1, Qubit arg2)
+{
+    target_.swap(this->map(arg1), this->map(arg2));
+}
+void PermutedQuantum::t_adj(Qubit arg1)
+{
+    target_.t_adj(this->map(arg1));
+}
+void PermutedQuantum::t(Qubit arg1)
+{
+    target_.t(this->map(arg1));
+}
+void PermutedQuantum::t(Array, Qubit)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::t_adj(Array, Qubit)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::x(Qubit arg1)
+{
+    target_.x(this->map(arg1));
+}
+void PermutedQuantum::x(Array, Qubit)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::y(Qubit arg1)
+{
+    target_.y(this->map(arg1));
+}
+void PermutedQuantum::y(Array, Qubit)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::z(Qubit arg1)
+{
+    target_.z(this->map(arg1));
+}
+void PermutedQuantum::z(Array, Qubit)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+
+//---------------------------------------------------------------------------//
+// ASSERTIONS
+//---------------------------------------------------------------------------//
+void PermutedQuantum::assertmeasurementprobability(
+    Array, Array, Result, double, String, double)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+void PermutedQuantum::assertmeasurementprobability(Array, Tuple)
+{
+    QIREE_NOT_IMPLEMENTED("qubit arrays with a permutation");
+}
+
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Order qubits so that strongly interacting ones have low, nearby indices.
+ *
+ * The returned vector maps each qubit of the analyzed circuit to its new
+ * index. The qubit with the most two-qubit interactions is placed first,
+ * then each following position takes the unplaced qubit with the most
+ * interactions with those already placed (ties go to the larger total
+ * interaction count, then the lower index). Qubits that never take part in a
+ * two-qubit operation keep their relative order at the end.
+ */
+PermutedQuantum::VecIndex
+locality_permutation(CircuitAnalysis const& analysis)
+{
+    size_type const num_qubits = analysis.num_qubits();
+
+    // Build the weighted interaction graph
+    std::vector<std::vector<std::pair<size_type, size_type>>> edges(
+        num_qubits);
+    std::vector<size_type> degree(num_qubits, 0);
+    for (auto const& [pair, count] : analysis.interactions())
+    {
+        auto [a, b] = pair;
+        QIREE_ASSERT(a < num_qubits && b < num_qubits);
+        edges[a].push_back({b, count});
+        edges[b].push_back({a, count});
+        degree[a] += count;
+        degree[b] += count;
+    }
+
+    // Greedily place the qubit most connected to the placed set
+    PermutedQuantum::VecIndex order;
+    order.reserve(num_qubits);
+    std::vector<bool> placed(num_qubits, false);
+    std::vector<size_type> affinity(num_qubits, 0);
+    while (true)
+    {
+        size_type best = num_qubits;
+        for (size_type q = 0; q < num_qubits; ++q)
+        {
+            if (placed[q] || degree[q] == 0)
+                continue;
+            if (best == num_qubits
+                || std::make_pair(affinity[q], degree[q])
+                       > std::make_pair(affinity[best], degree[best]))
+            {
+                best = q;
+            }
+        }
+        if (best == num_qubits)
+            break;
+
+        placed[best] = true;
+        order.push_back(best);
+        for (auto const& [other, count] : edges[best])
+        {
+            affinity[other] += count;
+        }
+    }
+    for (size_type q = 0; q < num_qubits; ++q)
+    {
+        if (!placed[q])
+        {
+            order.push_back(q);
+        }
+    }
+
+    // Invert the placement order to get the new index of each qubit
+    PermutedQuantum::VecIndex result(num_qubits);
+    for (size_type i = 0; i < num_qubits; ++i)
+    {
+        result[order[i]] = i;
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
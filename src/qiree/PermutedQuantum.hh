@@ -0,0 +1,138 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/PermutedQuantum.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <vector>
+
+#include "QuantumInterface.hh"
+
+namespace qiree
+{
+class CircuitAnalysis;
+
+//---------------------------------------------------------------------------//
+/*!
+ * Forward quantum instructions to another interface with relabeled qubits.
+ *
+ * Each qubit index \c i used by the program is replaced by \c perm[i] before
+ * the instruction reaches the target; indices past the end of the
+ * permutation are unchanged. Results are identified by their own IDs, so
+ * measurement outcomes, \c read_result , and recorded output are unaffected
+ * by the relabeling.
+ *
+ * Instructions that take qubits in an array are not supported, since the
+ * array contents are opaque to the interface.
+ *
+ * \code
+   auto perm = locality_permutation(CircuitAnalysis{module});
+   PermutedQuantum pq{sim, std::move(perm)};
+   execute(pq, rt);
+ * \endcode
+ */
+class PermutedQuantum final : public QuantumInterface
+{
+  public:
+    //! Logical-to-physical qubit index map
+    using VecIndex = std::vector<size_type>;
+
+  public:
+    // Construct with the target interface and the qubit permutation
+    PermutedQuantum(QuantumInterface& target, VecIndex perm);
+
+    //! Physical index for each logical qubit
+    VecIndex const& permutation() const { return perm_; }
+
+    //// SETUP ////
+
+    void set_up(EntryPointAttrs const&) final;
+    void tear_down() final;
+
+    //// MEASUREMENTS ////
+
+    Result m(Qubit) final;
+    Result measure(Array, Array) final;
+    Result mresetz(Qubit) final;
+    void mz(Qubit, Result) final;
+    QState read_result(Result) const final;
+
+    //// GATES ////
+
+    void ccx(Qubit, Qubit, Qubit) final;
+    void cnot(Qubit, Qubit) final;
+    void cx(Qubit, Qubit) final;
+    void cy(Qubit, Qubit) final;
+    void cz(Qubit, Qubit) final;
+    void exp_adj(Array, double, Array) final;
+    void exp(Array, double, Array) final;
+    void exp(Array, Tuple) final;
+    void exp_adj(Array, Tuple) final;
+    void h(Qubit) final;
+    void h(Array, Qubit) final;
+    void r_adj(Pauli, double, Qubit) final;
+    void r(Pauli, double, Qubit) final;
+    void r(Array, Tuple) final;
+    void r_adj(Array, Tuple) final;
+    void reset(Qubit) final;
+    void rx(double, Qubit) final;
+    void rx(Array, Tuple) final;
+    void rxx(double, Qubit, Qubit) final;
+    void ry(double, Qubit) final;
+    void ry(Array, Tuple) final;
+    void ryy(double, Qubit, Qubit) final;
+    void rz(double, Qubit) final;
+    void rz(Array, Tuple) final;
+    void rzz(double, Qubit, Qubit) final;
+    void s_adj(Qubit) final;
+    void s(Qubit) final;
+    void s(Array, Qubit) final;
+    void s_adj(Array, Qubit) final;
+    void swap(Qubit, Qubit) final;
+    void t_adj(Qubit) final;
+    void t(Qubit) final;
+    void t(Array, Qubit) final;
+    void t_adj(Array, Qubit) final;
+    void x(Qubit) final;
+    void x(Array, Qubit) final;
+    void y(Qubit) final;
+    void y(Array, Qubit) final;
+    void z(Qubit) final;
+    void z(Array, Qubit) final;
+
+    //// ASSERTIONS ////
+
+    void assertmeasurementprobability(
+        Array, Array, Result, double, String, double) final;
+    void assertmeasurementprobability(Array, Tuple) final;
+
+  private:
+    QuantumInterface& target_;
+    VecIndex perm_;
+
+    // Get the physical qubit for a logical one
+    inline Qubit map(Qubit q) const;
+};
+
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+// Order qubits so that strongly interacting ones have low, nearby indices
+PermutedQuantum::VecIndex locality_permutation(CircuitAnalysis const&);
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Get the physical qubit for a logical one.
+ */
+Qubit PermutedQuantum::map(Qubit q) const
+{
+    return q.value < perm_.size() ? Qubit{perm_[q.value]} : q;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
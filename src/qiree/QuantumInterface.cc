@@ -0,0 +1,28 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/QuantumInterface.cc
+//---------------------------------------------------------------------------//
+#include "QuantumInterface.hh"
+
+#include "GateTape.hh"
+#include "detail/GateDispatch.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Apply a block of gates and measurements in order.
+ *
+ * The default implementation calls the virtual function for each operation.
+ * Operations must not be runtime (output recording) calls.
+ */
+void QuantumInterface::apply(Span<GateOp const> ops)
+{
+    detail::dispatch_gates(ops, *this);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
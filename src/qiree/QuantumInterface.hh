@@ -7,10 +7,14 @@
 //---------------------------------------------------------------------------//
 #pragma once
 
+#include "Span.hh"
 #include "Types.hh"
 
 namespace qiree
 {
+//---------------------------------------------------------------------------//
+struct GateOp;
+
 //---------------------------------------------------------------------------//
 /*!
  * Interface class for quantum instruction set in the \c qis (quantum)
@@ -41,6 +45,11 @@ void r(Array, Tuple);  //!< ctl
 void r_adj(Pauli, double, Qubit);  //!< adj
  * \endverbatim
  *
+ * Blocks of gates (e.g., from a gate buffer or a recorded tape) can be sent
+ * with a single virtual call to \c apply . The default implementation calls
+ * the individual gate functions; backends that build a circuit can override
+ * it to append the whole block at once.
+ *
  * \note These are generated from scripts/dev/generate-bindings.py .
  */
 class QuantumInterface
@@ -118,6 +127,13 @@ class QuantumInterface
     virtual void assertmeasurementprobability(Array, Tuple) = 0;  //!< ctl
 
     //@}
+    //@{
+    //! \name Batched gates
+
+    // Apply a block of gates and measurements in order
+    virtual void apply(Span<GateOp const> ops);
+
+    //@}
 
   protected:
     virtual ~QuantumInterface() = default;
@@ -0,0 +1,64 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/QubitPool.cc
+//---------------------------------------------------------------------------//
+#include "QubitPool.hh"
+
+#include "Assert.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Get an unused qubit index.
+ */
+Qubit QubitPool::allocate()
+{
+    Qubit result;
+    if (!free_.empty())
+    {
+        result.value = free_.back();
+        free_.pop_back();
+        allocated_[result.value] = true;
+    }
+    else
+    {
+        result.value = allocated_.size();
+        allocated_.push_back(true);
+    }
+    ++num_allocated_;
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Return a qubit index to the pool.
+ *
+ * The qubit must have been allocated and not yet released.
+ */
+void QubitPool::release(Qubit q)
+{
+    QIREE_VALIDATE(q.value < allocated_.size() && allocated_[q.value],
+                   << "cannot release qubit " << q.value
+                   << ", which is not allocated");
+    allocated_[q.value] = false;
+    free_.push_back(q.value);
+    --num_allocated_;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Release all qubits and forget the peak usage.
+ */
+void QubitPool::clear()
+{
+    allocated_.clear();
+    free_.clear();
+    num_allocated_ = 0;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
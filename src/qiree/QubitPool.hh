@@ -0,0 +1,61 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/QubitPool.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <vector>
+
+#include "Types.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Assign qubit indices for programs with dynamic qubit management.
+ *
+ * Released indices are kept on a free list and reused (most recently released
+ * first) before new indices are created, so the indices handed out are always
+ * less than the peak number of simultaneously live qubits. A backend sized to
+ * \c capacity can thus run a program that allocates and releases many more
+ * qubits over its lifetime.
+ *
+ * Allocation and release are constant time.
+ *
+ * \code
+   QubitPool pool;
+   Qubit a = pool.allocate();  // Q{0}
+   Qubit b = pool.allocate();  // Q{1}
+   pool.release(a);
+   Qubit c = pool.allocate();  // Q{0}
+ * \endcode
+ */
+class QubitPool
+{
+  public:
+    // Get an unused qubit index
+    Qubit allocate();
+
+    // Return a qubit index to the pool
+    void release(Qubit q);
+
+    // Release all qubits and forget the peak usage
+    void clear();
+
+    //! Number of qubits currently allocated
+    size_type num_allocated() const { return num_allocated_; }
+
+    //! Peak number of simultaneously allocated qubits
+    size_type capacity() const { return allocated_.size(); }
+
+  private:
+    std::vector<bool> allocated_;
+    std::vector<size_type> free_;
+    size_type num_allocated_{0};
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
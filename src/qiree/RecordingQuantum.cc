@@ -0,0 +1,332 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/RecordingQuantum.cc
+//---------------------------------------------------------------------------//
+#include "RecordingQuantum.hh"
+
+#include "Assert.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with the target interface and the tape to append to.
+ */
+RecordingQuantum::RecordingQuantum(QuantumInterface& target, GateTape* tape)
+    : target_{target}, tape_{tape}
+{
+    QIREE_EXPECT(tape_);
+}
+
+//---------------------------------------------------------------------------//
+// SETUP
+//---------------------------------------------------------------------------//
+void RecordingQuantum::set_up(EntryPointAttrs const& attrs)
+{
+    target_.set_up(attrs);
+}
+void RecordingQuantum::tear_down()
+{
+    target_.tear_down();
+}
+
+//---------------------------------------------------------------------------//
+// MEASUREMENTS
+//---------------------------------------------------------------------------//
+Result RecordingQuantum::m(Qubit arg1)
+{
+    replayable_ = false;
+    return target_.m(arg1);
+}
+Result RecordingQuantum::measure(Array arg1, Array arg2)
+{
+    replayable_ = false;
+    return target_.measure(arg1, arg2);
+}
+Result RecordingQuantum::mresetz(Qubit arg1)
+{
+    replayable_ = false;
+    return target_.mresetz(arg1);
+}
+void RecordingQuantum::mz(Qubit arg1, Result arg2)
+{
+    target_.mz(arg1, arg2);
+    this->record(GateOpCode::mz, arg1.value, arg2.value);
+}
+QState RecordingQuantum::read_result(Result arg1) const
+{
+    replayable_ = false;
+    return target_.read_result(arg1);
+}
+
+//---------------------------------------------------------------------------//
+// GATES
+//---------------------------------------------------------------------------//
+void RecordingQuantum::ccx(Qubit arg1, Qubit arg2, Qubit arg3)
+{
+    target_.ccx(arg1, arg2, arg3);
+    this->record(GateOpCode::ccx, arg1.value, arg2.value, arg3.value);
+}
+void RecordingQuantum::cnot(Qubit arg1, Qubit arg2)
+{
+    target_.cnot(arg1, arg2);
+    this->record(GateOpCode::cnot, arg1.value, arg2.value);
+}
+void RecordingQuantum::cx(Qubit arg1, Qubit arg2)
+{
+    target_.cx(arg1, arg2);
+    this->record(GateOpCode::cx, arg1.value, arg2.value);
+}
+void RecordingQuantum::cy(Qubit arg1, Qubit arg2)
+{
+    target_.cy(arg1, arg2);
+    this->record(GateOpCode::cy, arg1.value, arg2.value);
+}
+void RecordingQuantum::cz(Qubit arg1, Qubit arg2)
+{
+    target_.cz(arg1, arg2);
+    this->record(GateOpCode::cz, arg1.value, arg2.value);
+}
+void RecordingQuantum::exp_adj(Array arg1, double arg2, Array arg3)
+{
+    target_.exp_adj(arg1, arg2, arg3);
+    this->record(GateOpCode::exp_adj, arg1.value, arg3.value, 0, arg2);
+}
+void RecordingQuantum::exp(Array arg1, double arg2, Array arg3)
+{
+    target_.exp(arg1, arg2, arg3);
+    this->record(GateOpCode::exp, arg1.value, arg3.value, 0, arg2);
+}
+void RecordingQuantum::exp(Array arg1, Tuple arg2)
+{
+    target_.exp(arg1, arg2);
+    this->record(GateOpCode::exp_ctl, arg1.value, arg2.value);
+}
+void RecordingQuantum::exp_adj(Array arg1, Tuple arg2)
+{
+    target_.exp_adj(arg1, arg2);
+    this->record(GateOpCode::exp_ctladj, arg1.value, arg2.value);
+}
+void RecordingQuantum::h(Qubit arg1)
+{
+    target_.h(arg1);
+    this->record(GateOpCode::h, arg1.value);
+}
+void RecordingQuantum::h(Array arg1, Qubit arg2)
+{
+    target_.h(arg1, arg2);
+    this->record(GateOpCode::h_ctl, arg1.value, arg2.value);
+}
+void RecordingQuantum::r_adj(Pauli arg1, double arg2, Qubit arg3)
+{
+    target_.r_adj(arg1, arg2, arg3);
+    this->record(GateOpCode::r_adj,
+                 static_cast<size_type>(arg1),
+                 arg3.value,
+                 0,
+                 arg2);
+}
+void RecordingQuantum::r(Pauli arg1, double arg2, Qubit arg3)
+{
+    target_.r(arg1, arg2, arg3);
+    this->record(GateOpCode::r,
+                 static_cast<size_type>(arg1),
+                 arg3.value,
+                 0,
+                 arg2);
+}
+void RecordingQuantum::r(Array arg1, Tuple arg2)
+{
+    target_.r(arg1, arg2);
+    this->record(GateOpCode::r_ctl, arg1.value, arg2.value);
+}
+void RecordingQuantum::r_adj(Array arg1, Tuple arg2)
+{
+    target_.r_adj(arg1, arg2);
+    this->record(GateOpCode::r_ctladj, arg1.value, arg2.value);
+}
+void RecordingQuantum::reset(Qubit arg1)
+{
+    target_.reset(arg1);
+    this->record(GateOpCode::reset, arg1.value);
+}
+void RecordingQuantum::rx(double arg1, Qubit arg2)
+{
+    target_.rx(arg1, arg2);
+    this->record(GateOpCode::rx, arg2.value, 0, 0, arg1);
+}
+void RecordingQuantum::rx(Array arg1, Tuple arg2)
+{
+    target_.rx(arg1, arg2);
+    this->record(GateOpCode::rx_ctl, arg1.value, arg2.value);
+}
+void RecordingQuantum::rxx(double arg1, Qubit arg2, Qubit arg3)
+{
+    target_.rxx(arg1, arg2, arg3);
+    this->record(GateOpCode::rxx, arg2.value, arg3.value, 0, arg1);
+}
+void RecordingQuantum::ry(double arg1, Qubit arg2)
+{
+    target_.ry(arg1, arg2);
+    this->record(GateOpCode::ry, arg2.value, 0, 0, arg1);
+}
+void RecordingQuantum::ry(Array arg1, Tuple arg2)
+{
+    target_.ry(arg1, arg2);
+    this->record(GateOpCode::ry_ctl, arg1.value, arg2.value);
+}
+void RecordingQuantum::ryy(double arg1, Qubit arg2, Qubit arg3)
+{
+    target_.ryy(arg1, arg2, arg3);
+    this->record(GateOpCode::ryy, arg2.value, arg3.value, 0, arg1);
+}
+void RecordingQuantum::rz(double arg1, Qubit arg2)
+{
+    target_.rz(arg1, arg2);
+    this->record(GateOpCode::rz, arg2.value, 0, 0, arg1);
+}
+void RecordingQuantum::rz(Array arg1, Tuple arg2)
+{
+    target_.rz(arg1, arg2);
+    this->record(GateOpCode::rz_ctl, arg1.value, arg2.value);
+}
+void RecordingQuantum::rzz(double arg1, Qubit arg2, Qubit arg3)
+{
+    target_.rzz(arg1, arg2, arg3);
+    this->record(GateOpCode::rzz, arg2.value, arg3.value, 0, arg1);
+}
+void RecordingQuantum::s_adj(Qubit arg1)
+{
+    target_.s_adj(arg1);
+    this->record(GateOpCode::s_adj, arg1.value);
+}
+void RecordingQuantum::s(Qubit arg1)
+{
+    target_.s(arg1);
+    this->record(GateOpCode::s, arg1.value);
+}
+void RecordingQuantum::s(Array arg1, Qubit arg2)
+{
+    target_.s(arg1, arg2);
+    this->record(GateOpCode::s_ctl, arg1.value, arg2.value);
+}
+void RecordingQuantum::s_adj(Array arg1, Qubit arg2)
+{
+    target_.s_adj(arg1, arg2);
+    this->record(GateOpCode::s_ctladj, arg1.value, arg2.value);
+}
+void RecordingQuantum::swap(Qubit arg1, Qubit arg2)
+{
+    target_.swap(arg1, arg2);
+    this->record(GateOpCode::swap, arg1.value, arg2.value);
+}
+void RecordingQuantum::t_adj(Qubit arg1)
+{
+    target_.t_adj(arg1);
+    this->record(GateOpCode::t_adj, arg1.value);
+}
+void RecordingQuantum::t(Qubit arg1)
+{
+    target_.t(arg1);
+    this->record(GateOpCode::t, arg1.value);
+}
+void RecordingQuantum::t(Array arg1, Qubit arg2)
+{
+    target_.t(arg1, arg2);
+    this->record(GateOpCode::t_ctl, arg1.value, arg2.value);
+}
+void RecordingQuantum::t_adj(Array arg1, Qubit arg2)
+{
+    target_.t_adj(arg1, arg2);
+    this->record(GateOpCode::t_ctladj, arg1.value, arg2.value);
+}
+void RecordingQuantum::x(Qubit arg1)
+{
+    target_.x(arg1);
+    this->record(GateOpCode::x, arg1.value);
+}
+void RecordingQuantum::x(Array arg1, Qubit arg2)
+{
+    target_.x(arg1, arg2);
+    this->record(GateOpCode::x_ctl, arg1.value, arg2.value);
+}
+void RecordingQuantum::y(Qubit arg1)
+{
+    target_.y(arg1);
+    this->record(GateOpCode::y, arg1.value);
+}
+void RecordingQuantum::y(Array arg1, Qubit arg2)
+{
+    target_.y(arg1, arg2);
+    this->record(GateOpCode::y_ctl, arg1.value, arg2.value);
+}
+void RecordingQuantum::z(Qubit arg1)
+{
+    target_.z(arg1);
+    this->record(GateOpCode::z, arg1.value);
+}
+void RecordingQuantum::z(Array arg1, Qubit arg2)
+{
+    target_.z(arg1, arg2);
+    this->record(GateOpCode::z_ctl, arg1.value, arg2.value);
+}
+
+//---------------------------------------------------------------------------//
+// ASSERTIONS
+//---------------------------------------------------------------------------//
+void RecordingQuantum::assertmeasurementprobability(Array arg1,
+                                                    Array arg2,
+                                                    Result arg3,
+                                                    double arg4,
+                                                    String arg5,
+                                                    double arg6)
+{
+    target_.assertmeasurementprobability(arg1, arg2, arg3, arg4, arg5, arg6);
+
+    GateOp op;
+    op.code = GateOpCode::assertmeasurementprobability;
+    op.ids = {arg1.value, arg2.value, arg3.value, arg5.value};
+    op.params = {arg4, arg6};
+    tape_->push_back(op);
+}
+void RecordingQuantum::assertmeasurementprobability(Array arg1, Tuple arg2)
+{
+    target_.assertmeasurementprobability(arg1, arg2);
+    this->record(
+        GateOpCode::assertmeasurementprobability_ctl, arg1.value, arg2.value);
+}
+
+//---------------------------------------------------------------------------//
+// BATCHED GATES
+//---------------------------------------------------------------------------//
+/*!
+ * Forward a block of gates with a single call and record each operation.
+ */
+void RecordingQuantum::apply(Span<GateOp const> ops)
+{
+    target_.apply(ops);
+    for (GateOp const& op : ops)
+    {
+        tape_->push_back(op);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Append an operation with up to three identifiers and one parameter.
+ */
+void RecordingQuantum::record(
+    GateOpCode code, size_type id0, size_type id1, size_type id2, double param)
+{
+    GateOp op;
+    op.code = code;
+    op.ids = {id0, id1, id2, 0};
+    op.params = {param, 0};
+    tape_->push_back(op);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
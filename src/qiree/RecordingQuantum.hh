@@ -0,0 +1,111 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/RecordingQuantum.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include "GateTape.hh"
+#include "QuantumInterface.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Forward quantum instructions to another interface while recording them.
+ *
+ * If the program calls an instruction whose return value the program could
+ * branch on (\c m, \c measure, \c mresetz, \c read_result), the recording is
+ * marked as not replayable.
+ */
+class RecordingQuantum final : public QuantumInterface
+{
+  public:
+    // Construct with the target interface and the tape to append to
+    RecordingQuantum(QuantumInterface& target, GateTape* tape);
+
+    //! Whether every recorded call can be replayed
+    bool replayable() const { return replayable_; }
+
+    //// SETUP ////
+
+    void set_up(EntryPointAttrs const&) final;
+    void tear_down() final;
+
+    //// MEASUREMENTS ////
+
+    Result m(Qubit) final;
+    Result measure(Array, Array) final;
+    Result mresetz(Qubit) final;
+    void mz(Qubit, Result) final;
+    QState read_result(Result) const final;
+
+    //// GATES ////
+
+    void ccx(Qubit, Qubit, Qubit) final;
+    void cnot(Qubit, Qubit) final;
+    void cx(Qubit, Qubit) final;
+    void cy(Qubit, Qubit) final;
+    void cz(Qubit, Qubit) final;
+    void exp_adj(Array, double, Array) final;
+    void exp(Array, double, Array) final;
+    void exp(Array, Tuple) final;
+    void exp_adj(Array, Tuple) final;
+    void h(Qubit) final;
+    void h(Array, Qubit) final;
+    void r_adj(Pauli, double, Qubit) final;
+    void r(Pauli, double, Qubit) final;
+    void r(Array, Tuple) final;
+    void r_adj(Array, Tuple) final;
+    void reset(Qubit) final;
+    void rx(double, Qubit) final;
+    void rx(Array, Tuple) final;
+    void rxx(double, Qubit, Qubit) final;
+    void ry(double, Qubit) final;
+    void ry(Array, Tuple) final;
+    void ryy(double, Qubit, Qubit) final;
+    void rz(double, Qubit) final;
+    void rz(Array, Tuple) final;
+    void rzz(double, Qubit, Qubit) final;
+    void s_adj(Qubit) final;
+    void s(Qubit) final;
+    void s(Array, Qubit) final;
+    void s_adj(Array, Qubit) final;
+    void swap(Qubit, Qubit) final;
+    void t_adj(Qubit) final;
+    void t(Qubit) final;
+    void t(Array, Qubit) final;
+    void t_adj(Array, Qubit) final;
+    void x(Qubit) final;
+    void x(Array, Qubit) final;
+    void y(Qubit) final;
+    void y(Array, Qubit) final;
+    void z(Qubit) final;
+    void z(Array, Qubit) final;
+
+    //// ASSERTIONS ////
+
+    void assertmeasurementprobability(
+        Array, Array, Result, double, String, double) final;
+    void assertmeasurementprobability(Array, Tuple) final;
+
+    //// BATCHED GATES ////
+
+    void apply(Span<GateOp const> ops) final;
+
+  private:
+    QuantumInterface& target_;
+    GateTape* tape_;
+    mutable bool replayable_{true};
+
+    void record(GateOpCode code,
+                size_type id0 = 0,
+                size_type id1 = 0,
+                size_type id2 = 0,
+                double param = 0);
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
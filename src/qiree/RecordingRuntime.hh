@@ -0,0 +1,128 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/RecordingRuntime.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include "GateTape.hh"
+#include "RuntimeInterface.hh"
+#include "qiree/Assert.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Forward runtime calls to another interface while recording them.
+ */
+class RecordingRuntime final : public RuntimeInterface
+{
+  public:
+    // Construct with the target interface and the tape to append to
+    inline RecordingRuntime(RuntimeInterface& target, GateTape* tape);
+
+    // Initialize the execution environment, resetting qubits
+    inline void initialize(OptionalCString env) final;
+
+    // Mark the following N results as being part of an array named tag
+    inline void array_record_output(size_type size, OptionalCString tag) final;
+
+    // Mark the following N results as being part of a tuple named tag
+    inline void tuple_record_output(size_type size, OptionalCString tag) final;
+
+    // Record one result into the program output
+    inline void
+    result_record_output(Result result, OptionalCString tag) final;
+
+    // Record a constant result into the program output
+    inline void constant_record_output(QState value, OptionalCString tag) final;
+
+  private:
+    RuntimeInterface& target_;
+    GateTape* tape_;
+
+    inline void record(GateOpCode code, size_type id, OptionalCString tag);
+};
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with the target interface and the tape to append to.
+ */
+RecordingRuntime::RecordingRuntime(RuntimeInterface& target, GateTape* tape)
+    : target_{target}, tape_{tape}
+{
+    QIREE_EXPECT(tape_);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Initialize the execution environment, resetting qubits.
+ */
+void RecordingRuntime::initialize(OptionalCString env)
+{
+    target_.initialize(env);
+    this->record(GateOpCode::initialize, 0, env);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Mark the following N results as being part of an array named tag.
+ */
+void RecordingRuntime::array_record_output(size_type size, OptionalCString tag)
+{
+    target_.array_record_output(size, tag);
+    this->record(GateOpCode::array_record_output, size, tag);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Mark the following N results as being part of a tuple named tag.
+ */
+void RecordingRuntime::tuple_record_output(size_type size, OptionalCString tag)
+{
+    target_.tuple_record_output(size, tag);
+    this->record(GateOpCode::tuple_record_output, size, tag);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Record one result into the program output.
+ */
+void RecordingRuntime::result_record_output(Result result, OptionalCString tag)
+{
+    target_.result_record_output(result, tag);
+    this->record(GateOpCode::result_record_output, result.value, tag);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Record a constant result into the program output.
+ */
+void RecordingRuntime::constant_record_output(QState value, OptionalCString tag)
+{
+    target_.constant_record_output(value, tag);
+    this->record(
+        GateOpCode::constant_record_output, static_cast<size_type>(value), tag);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Append an operation.
+ */
+void RecordingRuntime::record(GateOpCode code,
+                              size_type id,
+                              OptionalCString tag)
+{
+    GateOp op;
+    op.code = code;
+    op.ids[0] = id;
+    op.tag = tag;
+    tape_->push_back(op);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
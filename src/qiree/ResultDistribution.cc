@@ -38,6 +38,19 @@ std::string to_key(std::vector<bool> const& bits)
  * Accumulate a single shot.
  */
 void ResultDistribution::accumulate(RecordedResult const& result)
+{
+    this->accumulate(result, 1);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Accumulate the same result from several shots.
+ *
+ * This is used when shots are sampled from a simulated state rather than
+ * executed one at a time.
+ */
+void ResultDistribution::accumulate(RecordedResult const& result,
+                                    std::size_t count)
 {
     auto const& bits = result.bits();
 
@@ -54,7 +67,37 @@ void ResultDistribution::accumulate(RecordedResult const& result)
                        << key_length_);
     }
 
-    ++distribution_[to_key(bits)];
+    distribution_[to_key(bits)] += count;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Merge the counts from another distribution.
+ *
+ * This is used to reduce distributions accumulated on separate threads.
+ */
+void ResultDistribution::accumulate(ResultDistribution const& other)
+{
+    if (other.key_length_ == 0)
+    {
+        // Other distribution is empty
+        return;
+    }
+    if (key_length_ == 0)
+    {
+        key_length_ = other.key_length_;
+    }
+    else
+    {
+        QIREE_VALIDATE(other.key_length_ == key_length_,
+                       << "distribution key length " << other.key_length_
+                       << " does not match key length " << key_length_);
+    }
+
+    for (auto const& [key, count] : other.distribution_)
+    {
+        distribution_[key] += count;
+    }
 }
 
 //---------------------------------------------------------------------------//
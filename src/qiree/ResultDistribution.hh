@@ -37,6 +37,13 @@ class ResultDistribution
     // differs from previously accumulated ones.
     void accumulate(RecordedResult const& result);
 
+    // Accumulate the same result from several shots.
+    void accumulate(RecordedResult const& result, std::size_t count);
+
+    // Merge the counts from another distribution.
+    // Throws if the bit-lengths of the distributions differ.
+    void accumulate(ResultDistribution const& other);
+
     // Access the count for a given bit string key (e.g. "01001").
     // Returns 0 if the key is not present.
     std::size_t count(std::string const& key) const;
@@ -0,0 +1,28 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/RuntimeInterface.cc
+//---------------------------------------------------------------------------//
+#include "RuntimeInterface.hh"
+
+#include "Assert.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Record a constant result into the program output.
+ *
+ * Constant results are not stored by the quantum interface, so the runtime
+ * receives their value instead of a result handle. The default
+ * implementation raises an error.
+ */
+void RuntimeInterface::constant_record_output(QState, OptionalCString)
+{
+    QIREE_NOT_IMPLEMENTED("recording a constant result");
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
@@ -32,6 +32,15 @@ result_record_output(%Result* null, i8* null)
 result_record_output(%Result* inttoptr (i64 1 to %Result*), i8* null)
 result_record_output(%Result* inttoptr (i64 2 to %Result*), i8* null)
  * \endverbatim
+ *
+ * The executor itself implements the runtime functions for dynamic qubit and
+ * result management (\c qubit_allocate , \c qubit_release ,
+ * \c result_get_zero , \c result_get_one , \c result_equal , and
+ * \c result_update_reference_count ): allocated qubits are indices from a
+ * \c QubitPool , and results are read through the quantum interface. The
+ * results returned by \c m and \c mresetz are numbered after the entry
+ * point's static results, and the backend is sized for every measurement
+ * the program can make.
  */
 
 class RuntimeInterface
@@ -49,6 +58,9 @@ class RuntimeInterface
     //! Record one result into the program output
     virtual void result_record_output(Result result, OptionalCString tag) = 0;
 
+    // Record a constant (\c result_get_zero or \c result_get_one) result
+    virtual void constant_record_output(QState value, OptionalCString tag);
+
     virtual ~RuntimeInterface() = default;
 };
 
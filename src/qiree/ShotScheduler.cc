@@ -0,0 +1,329 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/ShotScheduler.cc
+//---------------------------------------------------------------------------//
+#include "ShotScheduler.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#include "Assert.hh"
+#include "Executor.hh"
+#include "GateTape.hh"
+#include "QuantumInterface.hh"
+#include "ResultDistribution.hh"
+#include "SingleResultRuntime.hh"
+
+namespace qiree
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Number of tasks per worker when the chunk size is automatic.
+ *
+ * Oversubscribing the queues lets idle workers steal leftover work near the
+ * end of a run.
+ */
+constexpr size_type tasks_per_worker = 8;
+
+//---------------------------------------------------------------------------//
+/*!
+ * Queue of shot chunks owned by one worker.
+ *
+ * The owner pops from the front; thieves pop from the back.
+ */
+class TaskQueue
+{
+  public:
+    //! Add a chunk (only called before workers start)
+    void push(size_type num_shots) { chunks_.push_back(num_shots); }
+
+    //! Take the next chunk as the owner
+    bool pop_front(size_type* num_shots)
+    {
+        std::lock_guard<std::mutex> scoped_lock{mutex_};
+        if (chunks_.empty())
+            return false;
+        *num_shots = chunks_.front();
+        chunks_.pop_front();
+        return true;
+    }
+
+    //! Take the last chunk as a thief
+    bool pop_back(size_type* num_shots)
+    {
+        std::lock_guard<std::mutex> scoped_lock{mutex_};
+        if (chunks_.empty())
+            return false;
+        *num_shots = chunks_.back();
+        chunks_.pop_back();
+        return true;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::deque<size_type> chunks_;
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Seed for a worker that avoids overlapping random streams.
+ *
+ * Backends typically increment their seed once per measurement, so workers
+ * seeded with consecutive integers would replay each other's outcomes. The
+ * seeds are instead spread evenly over the 32-bit range. Worker zero always
+ * has a seed of zero so that serial runs are unchanged.
+ */
+unsigned long int
+ShotScheduler::worker_seed(size_type worker, size_type num_workers)
+{
+    QIREE_EXPECT(worker < num_workers);
+    constexpr unsigned long int seed_range
+        = std::numeric_limits<std::uint32_t>::max();
+    return worker * (seed_range / num_workers);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with executor, backend factory, and options.
+ *
+ * The backends are created immediately (on the calling thread) and reused for
+ * every subsequent run.
+ */
+ShotScheduler::ShotScheduler(Executor const& execute,
+                             BackendFactory const& make_backend,
+                             ShotSchedulerOptions const& options)
+    : execute_{execute}
+    , chunk_size_{options.chunk_size}
+    , replay_{options.replay}
+    , compact_qubits_{options.compact_qubits}
+    , prune_lightcone_{options.prune_lightcone}
+{
+    QIREE_EXPECT(make_backend);
+
+    size_type num_workers = options.num_workers;
+    if (num_workers == 0)
+    {
+        num_workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    backends_.reserve(num_workers);
+    for (size_type i = 0; i < num_workers; ++i)
+    {
+        backends_.push_back(make_backend(i, num_workers));
+        QIREE_VALIDATE(backends_.back().quantum && backends_.back().runtime,
+                       << "backend factory did not create interfaces for "
+                          "worker "
+                       << i);
+    }
+}
+
+//---------------------------------------------------------------------------//
+//! Default destructor
+ShotScheduler::~ShotScheduler() = default;
+
+//---------------------------------------------------------------------------//
+/*!
+ * Run shots and return the merged distribution.
+ */
+ResultDistribution ShotScheduler::operator()(size_type num_shots)
+{
+    QIREE_EXPECT(num_shots > 0);
+
+    auto const start = std::chrono::steady_clock::now();
+
+    size_type const num_workers = std::min(this->num_workers(), num_shots);
+    size_type chunk_size = chunk_size_;
+    if (chunk_size == 0)
+    {
+        chunk_size = std::max<size_type>(
+            1, num_shots / (num_workers * tasks_per_worker));
+    }
+
+    // Deal chunks round-robin to the workers
+    std::vector<TaskQueue> queues(num_workers);
+    for (size_type i = 0, remaining = num_shots; remaining > 0; ++i)
+    {
+        size_type n = std::min(chunk_size, remaining);
+        queues[i % num_workers].push(n);
+        remaining -= n;
+    }
+
+    std::vector<ResultDistribution> distributions(num_workers);
+    std::vector<size_type> steals(num_workers, 0);
+    std::vector<size_type> replayed(num_workers, 0);
+    std::vector<size_type> widths(num_workers, 0);
+    std::vector<size_type> num_pruned(num_workers, 0);
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto run_worker = [&](size_type worker) {
+        // Take the next chunk from our queue, or steal one from another
+        auto next_chunk = [&](size_type* n) {
+            if (queues[worker].pop_front(n))
+                return true;
+            for (size_type i = 1; i < num_workers; ++i)
+            {
+                if (queues[(worker + i) % num_workers].pop_back(n))
+                {
+                    ++steals[worker];
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        try
+        {
+            auto& backend = backends_[worker];
+            auto& distribution = distributions[worker];
+
+            auto accumulate = [&distribution, &backend](size_type) {
+                distribution.accumulate(backend.runtime->result());
+            };
+
+            // Record the first shot of a shot-invariant program
+            GateTape tape;
+            GateTape pruned;
+            GateTape compacted;
+            GateTape const* replay_tape = &tape;
+            bool record = replay_ && execute_.shot_invariant();
+            bool use_tape = false;
+            size_type& width = widths[worker];
+
+            size_type n{0};
+            while (!failed && next_chunk(&n))
+            {
+                size_type i = 0;
+                if (record)
+                {
+                    use_tape = execute_.record(
+                        *backend.quantum, *backend.runtime, &tape);
+                    accumulate(i++);
+                    record = false;
+                    if (use_tape && prune_lightcone_)
+                    {
+                        num_pruned[worker]
+                            = prune_lightcone(*replay_tape, &pruned);
+                        replay_tape = &pruned;
+                    }
+                    if (use_tape && compact_qubits_)
+                    {
+                        width = compact_qubits(*replay_tape, &compacted);
+                        if (width > 0)
+                        {
+                            replay_tape = &compacted;
+                        }
+                    }
+                }
+                if (use_tape)
+                {
+                    replayed[worker] += n - i;
+                    for (; i < n; ++i)
+                    {
+                        if (width > 0)
+                        {
+                            execute_.replay(*replay_tape,
+                                            width,
+                                            *backend.quantum,
+                                            *backend.runtime);
+                        }
+                        else
+                        {
+                            execute_.replay(*replay_tape,
+                                            *backend.quantum,
+                                            *backend.runtime);
+                        }
+                        accumulate(i);
+                    }
+                }
+                else if (i < n)
+                {
+                    execute_.run_shots(
+                        *backend.quantum, *backend.runtime, n - i, accumulate);
+                }
+            }
+        }
+        catch (...)
+        {
+            failed = true;
+            std::lock_guard<std::mutex> scoped_lock{error_mutex};
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    if (num_workers == 1)
+    {
+        // Avoid thread overhead for serial execution
+        run_worker(0);
+    }
+    else
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(num_workers);
+        for (size_type i = 0; i < num_workers; ++i)
+        {
+            threads.emplace_back(run_worker, i);
+        }
+        for (auto& t : threads)
+        {
+            t.join();
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+
+    // Reduce the per-worker distributions
+    ResultDistribution result = std::move(distributions.front());
+    for (size_type i = 1; i < num_workers; ++i)
+    {
+        result.accumulate(distributions[i]);
+    }
+
+    stats_.num_shots = num_shots;
+    stats_.num_workers = num_workers;
+    stats_.num_steals = 0;
+    for (auto s : steals)
+    {
+        stats_.num_steals += s;
+    }
+    stats_.num_replayed = 0;
+    for (auto r : replayed)
+    {
+        stats_.num_replayed += r;
+    }
+    // Tape statistics are the same for every worker that recorded one
+    stats_.replay_qubits
+        = *std::max_element(widths.begin(), widths.end());
+    stats_.gates_pruned
+        = *std::max_element(num_pruned.begin(), num_pruned.end());
+    stats_.seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
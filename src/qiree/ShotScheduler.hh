@@ -0,0 +1,146 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/ShotScheduler.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Macros.hh"
+#include "Types.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+class Executor;
+class QuantumInterface;
+class ResultDistribution;
+class SingleResultRuntime;
+
+//---------------------------------------------------------------------------//
+/*!
+ * Scheduling options for running shots in parallel.
+ */
+struct ShotSchedulerOptions
+{
+    //! Number of worker threads (zero for the hardware concurrency)
+    size_type num_workers{1};
+    //! Number of shots per scheduled task (zero for automatic)
+    size_type chunk_size{0};
+    //! Record shot-invariant programs once and replay the calls
+    bool replay{true};
+    //! Replay on fewer qubits by reusing measured qubits' indices
+    bool compact_qubits{false};
+    //! Omit replayed gates that cannot affect the recorded results
+    bool prune_lightcone{false};
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Timing and load-balancing statistics from a scheduled run.
+ *
+ * The counts are summed over workers, except for \c replay_qubits and
+ * \c gates_pruned , which describe the tape replayed by every worker. (Each
+ * worker records its own tape, but only shot-invariant programs are
+ * replayed, so the tapes are identical.)
+ */
+struct ShotStats
+{
+    size_type num_shots{};  //!< Total number of shots executed
+    size_type num_workers{};  //!< Number of workers that ran shots
+    size_type num_steals{};  //!< Number of tasks taken from another worker
+    size_type num_replayed{};  //!< Number of shots replayed from a tape
+    size_type replay_qubits{};  //!< Width of the compacted tape (if any)
+    size_type gates_pruned{};  //!< Operations omitted from the tape per shot
+    double seconds{};  //!< Wall time of the run
+
+    //! Throughput of the run
+    double shots_per_second() const
+    {
+        return seconds > 0 ? static_cast<double>(num_shots) / seconds : 0;
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Run shots of a compiled executor on a pool of worker threads.
+ *
+ * Each worker owns an independent quantum and runtime interface created by
+ * the user-supplied factory, so backends never share state. Shots are divided
+ * into chunks dealt round-robin to the workers; a worker that runs out of
+ * chunks steals from the back of another worker's queue. Each worker
+ * accumulates its own \c ResultDistribution, and these are merged once all
+ * shots are complete.
+ *
+ * If the executor's program is shot-invariant (it never reads a measurement
+ * result), each worker records the QIR calls of its first shot to a
+ * \c GateTape and replays the tape for the remaining shots, bypassing the
+ * compiled program entirely. Optionally, the recorded qubits are renumbered
+ * with \c compact_qubits so that the replayed state only has as many qubits
+ * as are simultaneously live, and operations outside the lightcone of the
+ * recorded results are omitted with \c prune_lightcone .
+ *
+ * \code
+   ShotScheduler schedule(execute, [](size_type worker, size_type count) {
+       auto sim = std::make_shared<QsimQuantum>(
+           std::cout, ShotScheduler::worker_seed(worker, count));
+       auto rt = std::make_shared<QsimRuntime>(std::cout, *sim);
+       return ShotScheduler::Backend{std::move(sim), std::move(rt)};
+   }, options);
+   ResultDistribution distribution = schedule(num_shots);
+ * \endcode
+ */
+class ShotScheduler
+{
+  public:
+    //! Quantum and runtime interfaces owned by a single worker
+    struct Backend
+    {
+        std::shared_ptr<QuantumInterface> quantum;
+        std::shared_ptr<SingleResultRuntime> runtime;
+    };
+
+    //! Create the backend for a worker given its index and the worker count
+    using BackendFactory = std::function<Backend(size_type, size_type)>;
+
+  public:
+    // Seed for a worker that avoids overlapping random streams
+    static unsigned long int
+    worker_seed(size_type worker, size_type num_workers);
+
+    // Construct with executor, backend factory, and options
+    ShotScheduler(Executor const& execute,
+                  BackendFactory const& make_backend,
+                  ShotSchedulerOptions const& options);
+
+    // Default destructor
+    ~ShotScheduler();
+
+    QIREE_DELETE_COPY_MOVE(ShotScheduler);
+
+    // Run shots and return the merged distribution
+    ResultDistribution operator()(size_type num_shots);
+
+    //! Number of worker threads
+    size_type num_workers() const { return backends_.size(); }
+
+    //! Statistics from the most recent run
+    ShotStats const& stats() const { return stats_; }
+
+  private:
+    Executor const& execute_;
+    size_type chunk_size_;
+    bool replay_;
+    bool compact_qubits_;
+    bool prune_lightcone_;
+    std::vector<Backend> backends_;
+    ShotStats stats_;
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
@@ -33,5 +33,12 @@ void SingleResultRuntime::result_record_output(Result result,
     result_.push_back(sim_->read_result(result), tag);
 }
 
+//! Save one constant result
+void SingleResultRuntime::constant_record_output(QState value,
+                                                 OptionalCString tag)
+{
+    result_.push_back(value, tag);
+}
+
 //---------------------------------------------------------------------------//
 }  // namespace qiree
@@ -30,6 +30,9 @@ class SingleResultRuntime : public RuntimeInterface
     // Save one result
     void result_record_output(Result result, OptionalCString tag) final;
 
+    // Save one constant result
+    void constant_record_output(QState value, OptionalCString tag) final;
+
     //! Access the saved results
     RecordedResult const& result() const { return result_; }
 
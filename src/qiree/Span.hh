@@ -0,0 +1,94 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/Span.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "Assert.hh"
+#include "Types.hh"
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Non-owning view of a contiguous range of elements.
+ *
+ * This is a minimal replacement for C++20 \c std::span . The element type may
+ * be incomplete where the span is only passed by value.
+ *
+ * \code
+   std::vector<GateOp> ops = ...;
+   quantum.apply(Span<GateOp const>{ops});
+ * \endcode
+ */
+template<class T>
+class Span
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+    //!@}
+
+  public:
+    //! Construct an empty span
+    constexpr Span() = default;
+
+    //! Construct from a pointer and a number of elements
+    constexpr Span(pointer data, size_type size) : data_{data}, size_{size}
+    {
+    }
+
+    //! Construct from a vector
+    template<class U, class A>
+    Span(std::vector<U, A>& v) : data_{v.data()}, size_{v.size()}
+    {
+    }
+
+    //! Construct from a const vector (const elements only)
+    template<class U, class A>
+    Span(std::vector<U, A> const& v) : data_{v.data()}, size_{v.size()}
+    {
+    }
+
+    //!@{
+    //! \name Accessors
+    constexpr pointer data() const { return data_; }
+    constexpr size_type size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    constexpr iterator begin() const { return data_; }
+    constexpr iterator end() const { return data_ + size_; }
+    //!@}
+
+    //! Access an element
+    reference operator[](size_type i) const
+    {
+        QIREE_EXPECT(i < size_);
+        return data_[i];
+    }
+
+    //! Get a view of a subrange
+    Span subspan(size_type offset, size_type count) const
+    {
+        QIREE_EXPECT(offset + count <= size_);
+        return {data_ + offset, count};
+    }
+
+  private:
+    pointer data_{nullptr};
+    size_type size_{0};
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
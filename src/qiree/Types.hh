@@ -86,6 +86,21 @@ enum class Pauli : pauli_type
     y = 3,
 };
 
+//---------------------------------------------------------------------------//
+/*!
+ * Whether a program's quantum operations depend on measurement outcomes.
+ *
+ * A static circuit applies the same gates on every shot, so its final state
+ * can be simulated once and sampled for every shot. A dynamic circuit uses
+ * measurement outcomes for control flow or as gate arguments and must be
+ * executed shot by shot.
+ */
+enum class ExecutionClass
+{
+    static_circuit,  //!< Gates are independent of measurement outcomes
+    dynamic_circuit,  //!< Measurement outcomes affect later gates
+};
+
 //---------------------------------------------------------------------------//
 // TYPE ALIASES
 //---------------------------------------------------------------------------//
@@ -0,0 +1,95 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/BlockArena.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "qiree/Assert.hh"
+#include "qiree/Types.hh"
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Append-only storage allocated in fixed-size blocks.
+ *
+ * Each allocation is contiguous and addressed by an integer index. Unlike a
+ * \c std::vector , growing the arena never moves existing values, and
+ * clearing it keeps the blocks for reuse so that refilling an arena of the
+ * same size performs no heap allocation.
+ */
+template<class T, size_type BlockSize = 512>
+class BlockArena
+{
+    static_assert(BlockSize > 0);
+
+  public:
+    // Allocate contiguous storage for a number of values
+    inline size_type allocate(size_type count);
+
+    //! Remove all values but keep the allocated blocks
+    void clear() { size_ = 0; }
+
+    //! One past the index of the last allocation
+    size_type size() const { return size_; }
+
+    //!@{
+    //! Access the storage for an allocation
+    T* data(size_type index)
+    {
+        return blocks_[index / BlockSize].get() + index % BlockSize;
+    }
+    T const* data(size_type index) const
+    {
+        return blocks_[index / BlockSize].get() + index % BlockSize;
+    }
+    //!@}
+
+  private:
+    std::vector<std::unique_ptr<T[]>> blocks_;
+    size_type size_{0};
+};
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Allocate contiguous storage for a number of values.
+ *
+ * The values are value-initialized only when a new block is created. An
+ * allocation that would straddle two blocks starts at the next block instead.
+ * The block containing the returned index always exists, even for an empty
+ * allocation, so that \c data is valid for every index.
+ */
+template<class T, size_type BlockSize>
+size_type BlockArena<T, BlockSize>::allocate(size_type count)
+{
+    QIREE_EXPECT(count <= BlockSize);
+
+    if (size_ % BlockSize + count > BlockSize)
+    {
+        // Skip the remainder of the current block
+        size_ += BlockSize - size_ % BlockSize;
+    }
+
+    size_type const index = size_;
+    size_ += count;
+    while (blocks_.size() * BlockSize < std::max(size_, index + 1))
+    {
+        blocks_.push_back(std::make_unique<T[]>(BlockSize));
+    }
+    return index;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
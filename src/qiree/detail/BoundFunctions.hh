@@ -0,0 +1,201 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/BoundFunctions.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <cstdint>
+
+#include "ResultHandle.hh"
+#include "qiree/Executor.hh"
+#include "qiree/QuantumInterface.hh"
+#include "qiree/RuntimeInterface.hh"
+#include "qiree/Types.hh"
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * QIR function trampolines that call a concrete backend.
+ *
+ * Each static function has the same signature as the corresponding wrapper
+ * in \c Executor.cc but calls the member function of \c Q or \c R directly.
+ * When the backend declares its implementations \c final (as the QIR-EE
+ * backends do), the compiler resolves the call statically and can inline it
+ * into the trampoline. Only functions taking qubits and results are bound:
+ * the rarely used array and tuple overloads keep the virtual wrappers, as do
+ * \c m and \c mresetz , which allocate their results in the executor.
+ *
+ * The interface pointers are thread-local so that, like \c Executor, a bound
+ * executor may be called concurrently from multiple threads.
+ */
+template<class Q, class R>
+struct BoundFunctions
+{
+    using uintptr_t = std::uintptr_t;
+
+    static inline thread_local Q* quantum{nullptr};
+    static inline thread_local R* runtime{nullptr};
+
+    //// MEASUREMENTS ////
+
+    static void mz(uintptr_t q, uintptr_t r)
+    {
+        quantum->mz(Qubit{q}, Result{r});
+    }
+    static bool read_result(uintptr_t r)
+    {
+        if (is_constant_result(r))
+        {
+            return static_cast<bool>(constant_result(r));
+        }
+        return static_cast<bool>(quantum->read_result(Result{r}));
+    }
+
+    //// GATES ////
+
+    static void ccx(uintptr_t q1, uintptr_t q2, uintptr_t q3)
+    {
+        quantum->ccx(Qubit{q1}, Qubit{q2}, Qubit{q3});
+    }
+    static void cnot(uintptr_t q1, uintptr_t q2)
+    {
+        quantum->cnot(Qubit{q1}, Qubit{q2});
+    }
+    static void cx(uintptr_t q1, uintptr_t q2)
+    {
+        quantum->cx(Qubit{q1}, Qubit{q2});
+    }
+    static void cy(uintptr_t q1, uintptr_t q2)
+    {
+        quantum->cy(Qubit{q1}, Qubit{q2});
+    }
+    static void cz(uintptr_t q1, uintptr_t q2)
+    {
+        quantum->cz(Qubit{q1}, Qubit{q2});
+    }
+    static void h(uintptr_t q) { quantum->h(Qubit{q}); }
+    static void r_adj(pauli_type p, double theta, uintptr_t q)
+    {
+        quantum->r_adj(static_cast<Pauli>(p), theta, Qubit{q});
+    }
+    static void r(pauli_type p, double theta, uintptr_t q)
+    {
+        quantum->r(static_cast<Pauli>(p), theta, Qubit{q});
+    }
+    static void reset(uintptr_t q) { quantum->reset(Qubit{q}); }
+    static void rx(double theta, uintptr_t q) { quantum->rx(theta, Qubit{q}); }
+    static void rxx(double theta, uintptr_t q1, uintptr_t q2)
+    {
+        quantum->rxx(theta, Qubit{q1}, Qubit{q2});
+    }
+    static void ry(double theta, uintptr_t q) { quantum->ry(theta, Qubit{q}); }
+    static void ryy(double theta, uintptr_t q1, uintptr_t q2)
+    {
+        quantum->ryy(theta, Qubit{q1}, Qubit{q2});
+    }
+    static void rz(double theta, uintptr_t q) { quantum->rz(theta, Qubit{q}); }
+    static void rzz(double theta, uintptr_t q1, uintptr_t q2)
+    {
+        quantum->rzz(theta, Qubit{q1}, Qubit{q2});
+    }
+    static void s_adj(uintptr_t q) { quantum->s_adj(Qubit{q}); }
+    static void s(uintptr_t q) { quantum->s(Qubit{q}); }
+    static void swap(uintptr_t q1, uintptr_t q2)
+    {
+        quantum->swap(Qubit{q1}, Qubit{q2});
+    }
+    static void t_adj(uintptr_t q) { quantum->t_adj(Qubit{q}); }
+    static void t(uintptr_t q) { quantum->t(Qubit{q}); }
+    static void x(uintptr_t q) { quantum->x(Qubit{q}); }
+    static void y(uintptr_t q) { quantum->y(Qubit{q}); }
+    static void z(uintptr_t q) { quantum->z(Qubit{q}); }
+
+    //// RUNTIME ////
+
+    static void initialize(OptionalCString env) { runtime->initialize(env); }
+    static void array_record_output(size_type s, OptionalCString tag)
+    {
+        runtime->array_record_output(s, tag);
+    }
+    static void tuple_record_output(size_type s, OptionalCString tag)
+    {
+        runtime->tuple_record_output(s, tag);
+    }
+    static void result_record_output(uintptr_t r, OptionalCString tag)
+    {
+        if (is_constant_result(r))
+        {
+            return runtime->constant_record_output(constant_result(r), tag);
+        }
+        runtime->result_record_output(Result{r}, tag);
+    }
+
+    // Map QIR symbol names to the trampolines
+    static FunctionOverrides overrides();
+};
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Map QIR symbol names to the trampolines.
+ */
+template<class Q, class R>
+FunctionOverrides BoundFunctions<Q, R>::overrides()
+{
+    FunctionOverrides result;
+    auto add = [&result](char const* name, auto* func) {
+        result.emplace(name, reinterpret_cast<void (*)()>(func));
+    };
+#define QIREE_BIND_QIS(FUNC, SUFFIX) \
+    add("__quantum__qis__" #FUNC "__" #SUFFIX, &FUNC)
+#define QIREE_BIND_QIS_ADJ(FUNC) \
+    add("__quantum__qis__" #FUNC "__adj", &FUNC##_adj)
+#define QIREE_BIND_RT(FUNC) add("__quantum__rt__" #FUNC, &FUNC)
+    // Measurements
+    QIREE_BIND_QIS(mz, body);
+    QIREE_BIND_QIS(read_result, body);
+    // Gates
+    QIREE_BIND_QIS(ccx, body);
+    QIREE_BIND_QIS(cnot, body);
+    QIREE_BIND_QIS(cx, body);
+    QIREE_BIND_QIS(cy, body);
+    QIREE_BIND_QIS(cz, body);
+    QIREE_BIND_QIS(h, body);
+    QIREE_BIND_QIS_ADJ(r);
+    QIREE_BIND_QIS(r, body);
+    QIREE_BIND_QIS(reset, body);
+    QIREE_BIND_QIS(rx, body);
+    QIREE_BIND_QIS(rxx, body);
+    QIREE_BIND_QIS(ry, body);
+    QIREE_BIND_QIS(ryy, body);
+    QIREE_BIND_QIS(rz, body);
+    QIREE_BIND_QIS(rzz, body);
+    QIREE_BIND_QIS_ADJ(s);
+    QIREE_BIND_QIS(s, body);
+    QIREE_BIND_QIS(swap, body);
+    QIREE_BIND_QIS_ADJ(t);
+    QIREE_BIND_QIS(t, body);
+    QIREE_BIND_QIS(x, body);
+    QIREE_BIND_QIS(y, body);
+    QIREE_BIND_QIS(z, body);
+    // Runtime
+    QIREE_BIND_RT(initialize);
+    QIREE_BIND_RT(array_record_output);
+    QIREE_BIND_RT(tuple_record_output);
+    QIREE_BIND_RT(result_record_output);
+#undef QIREE_BIND_RT
+#undef QIREE_BIND_QIS_ADJ
+#undef QIREE_BIND_QIS
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,132 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/CallBound.cc
+//---------------------------------------------------------------------------//
+#include "CallBound.hh"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <llvm/ADT/SCCIterator.h>
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+
+namespace qiree
+{
+namespace detail
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Count the calls made by each function, ignoring branch conditions.
+ */
+class CallCounter
+{
+  public:
+    using OptCount = std::optional<size_type>;
+
+    //! Construct with the names of the counted functions
+    explicit CallCounter(llvm::ArrayRef<llvm::StringRef> names)
+        : names_{names}
+    {
+    }
+
+    // Get the maximum number of calls made by one invocation
+    OptCount operator()(llvm::Function const& f);
+
+  private:
+    llvm::ArrayRef<llvm::StringRef> names_;
+    std::unordered_map<llvm::Function const*, OptCount> counts_;
+    std::unordered_set<llvm::Function const*> active_;
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the maximum number of calls made by one invocation of a function.
+ *
+ * Every block is assumed to execute once, which overestimates the count of
+ * branching code. Calls inside a loop, recursive calls, and indirect calls
+ * have no bound.
+ */
+auto CallCounter::operator()(llvm::Function const& f) -> OptCount
+{
+    if (auto iter = counts_.find(&f); iter != counts_.end())
+    {
+        return iter->second;
+    }
+    if (!active_.insert(&f).second)
+    {
+        // Recursion
+        return std::nullopt;
+    }
+
+    OptCount result{0};
+    for (auto scc = llvm::scc_begin(&f); result && !scc.isAtEnd(); ++scc)
+    {
+        bool const in_loop = scc.hasCycle();
+        for (llvm::BasicBlock const* block : *scc)
+        {
+            for (llvm::Instruction const& inst : *block)
+            {
+                auto* call = llvm::dyn_cast<llvm::CallBase>(&inst);
+                if (!call || call->isInlineAsm())
+                    continue;
+
+                OptCount count{0};
+                llvm::Function const* callee = call->getCalledFunction();
+                if (!callee)
+                {
+                    count = std::nullopt;
+                }
+                else if (llvm::is_contained(names_, callee->getName()))
+                {
+                    count = 1;
+                }
+                else if (!callee->isDeclaration())
+                {
+                    count = (*this)(*callee);
+                }
+
+                if (!count || (in_loop && *count > 0))
+                {
+                    result = std::nullopt;
+                    break;
+                }
+                *result += *count;
+            }
+            if (!result)
+                break;
+        }
+    }
+
+    active_.erase(&f);
+    counts_[&f] = result;
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get an upper bound on the number of calls to functions in one execution.
+ *
+ * This counts the calls to any of the named functions in the entry point and
+ * the functions it calls, as if every branch were taken. It is used to size
+ * the backend for programs whose control flow depends on measurements, where
+ * the exact count is unknown. The result is empty if a call may be
+ * repeated an unbounded number of times by a loop or recursion.
+ */
+std::optional<size_type> max_num_calls(llvm::Function const& entry,
+                                       llvm::ArrayRef<llvm::StringRef> names)
+{
+    return CallCounter{names}(entry);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,32 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/CallBound.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <optional>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
+
+#include "qiree/Types.hh"
+
+namespace llvm
+{
+class Function;
+}  // namespace llvm
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+// Get an upper bound on the number of calls to functions in one execution
+std::optional<size_type> max_num_calls(llvm::Function const& entry,
+                                       llvm::ArrayRef<llvm::StringRef> names);
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
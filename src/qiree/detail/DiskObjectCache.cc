@@ -0,0 +1,155 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/DiskObjectCache.cc
+//---------------------------------------------------------------------------//
+#include "DiskObjectCache.hh"
+
+#include <utility>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+#if LLVM_VERSION_MAJOR >= 17
+#    include <llvm/TargetParser/Host.h>
+#else
+#    include <llvm/Support/Host.h>
+#endif
+
+#include "qiree_version.h"
+
+#include "qiree/Assert.hh"
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with a directory and a key for compilation options.
+ *
+ * The directory is created if it does not exist.
+ */
+DiskObjectCache::DiskObjectCache(std::string directory, std::string salt)
+    : directory_{std::move(directory)}, salt_{std::move(salt)}
+{
+    QIREE_EXPECT(!directory_.empty());
+    auto ec = llvm::sys::fs::create_directories(directory_);
+    QIREE_VALIDATE(!ec,
+                   << "failed to create object cache directory '"
+                   << directory_ << "': " << ec.message());
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Save a newly compiled object.
+ */
+void DiskObjectCache::notifyObjectCompiled(llvm::Module const* mod,
+                                           llvm::MemoryBufferRef obj)
+{
+    QIREE_EXPECT(mod);
+
+    std::string key;
+    {
+        std::lock_guard<std::mutex> scoped_lock{pending_mutex_};
+        auto iter = pending_.find(mod);
+        if (iter == pending_.end())
+        {
+            // Object was not requested through the cache first
+            return;
+        }
+        key = std::move(iter->second);
+        pending_.erase(iter);
+    }
+
+    // Write to a unique temporary file, then atomically move into place
+    std::string const dest = this->path(key);
+    int fd{-1};
+    llvm::SmallString<256> temp_path;
+    if (llvm::sys::fs::createUniqueFile(dest + ".tmp-%%%%%%", fd, temp_path))
+    {
+        return;
+    }
+    {
+        llvm::raw_fd_ostream os(fd, /* shouldClose = */ true);
+        os << obj.getBuffer();
+        os.close();
+        if (os.has_error())
+        {
+            os.clear_error();
+            llvm::sys::fs::remove(temp_path);
+            return;
+        }
+    }
+    if (llvm::sys::fs::rename(temp_path, dest))
+    {
+        llvm::sys::fs::remove(temp_path);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Load a previously compiled object, or null if not present.
+ */
+std::unique_ptr<llvm::MemoryBuffer>
+DiskObjectCache::getObject(llvm::Module const* mod)
+{
+    QIREE_EXPECT(mod);
+
+    std::string key = this->key(*mod);
+    auto buffer = llvm::MemoryBuffer::getFile(this->path(key),
+                                              /* IsText = */ false,
+                                              /* RequiresNullTerminator = */
+                                              false);
+    if (buffer)
+    {
+        ++num_hits_;
+        return std::move(*buffer);
+    }
+
+    // Save the key so the compiled object can be stored
+    ++num_misses_;
+    std::lock_guard<std::mutex> scoped_lock{pending_mutex_};
+    pending_[mod] = std::move(key);
+    return nullptr;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Calculate the cache key for a module.
+ */
+std::string DiskObjectCache::key(llvm::Module const& mod) const
+{
+    std::string data;
+    {
+        llvm::raw_string_ostream os(data);
+        llvm::WriteBitcodeToFile(mod, os);
+        os << '\0' << llvm::sys::getProcessTriple() << '\0'
+           << llvm::sys::getHostCPUName() << '\0' << qiree_version << '\0'
+           << LLVM_VERSION_STRING << '\0' << salt_;
+    }
+    return llvm::toHex(llvm::SHA1::hash(llvm::arrayRefFromStringRef(data)),
+                       /* LowerCase = */ true);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the path to the object file for a key.
+ */
+std::string DiskObjectCache::path(std::string const& key) const
+{
+    llvm::SmallString<256> result{directory_};
+    llvm::sys::path::append(result, key + ".o");
+    return std::string(result);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
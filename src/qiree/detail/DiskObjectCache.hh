@@ -0,0 +1,73 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/DiskObjectCache.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+
+#include "qiree/Macros.hh"
+#include "qiree/Types.hh"
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Store compiled objects on disk, keyed by a hash of the module.
+ *
+ * The key is the SHA-1 of the module's bitcode, the host target triple and
+ * CPU, the QIR-EE and LLVM versions, and a caller-supplied "salt" describing
+ * compilation options. Objects are written to a temporary file and renamed
+ * into place so that concurrent processes can share a directory. Failures to
+ * read or write the cache are not errors: the module is simply recompiled.
+ */
+class DiskObjectCache final : public llvm::ObjectCache
+{
+  public:
+    // Construct with a directory and a key for compilation options
+    DiskObjectCache(std::string directory, std::string salt);
+
+    QIREE_DELETE_COPY_MOVE(DiskObjectCache);
+
+    // Save a newly compiled object
+    void notifyObjectCompiled(llvm::Module const* mod,
+                              llvm::MemoryBufferRef obj) final;
+
+    // Load a previously compiled object, or null if not present
+    std::unique_ptr<llvm::MemoryBuffer>
+    getObject(llvm::Module const* mod) final;
+
+    // Calculate the cache key for a module
+    std::string key(llvm::Module const& mod) const;
+
+    //! Number of modules loaded from disk
+    size_type num_hits() const { return num_hits_; }
+
+    //! Number of modules that had to be compiled
+    size_type num_misses() const { return num_misses_; }
+
+  private:
+    std::string directory_;
+    std::string salt_;
+
+    std::mutex pending_mutex_;
+    std::unordered_map<llvm::Module const*, std::string> pending_;
+
+    std::atomic<size_type> num_hits_{0};
+    std::atomic<size_type> num_misses_{0};
+
+    std::string path(std::string const& key) const;
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,387 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/GateBuffer.cc
+//---------------------------------------------------------------------------//
+#include "GateBuffer.hh"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+
+#include "qiree/Assert.hh"
+
+namespace qiree
+{
+namespace detail
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+// TYPES
+//---------------------------------------------------------------------------//
+//! QIS function that can be buffered: angles followed by qubits
+struct BufferedGate
+{
+    char const* name;
+    GateOpCode code;
+    unsigned num_params;
+    unsigned num_qubits;
+};
+
+static_assert(std::is_standard_layout_v<GateOp>);
+static_assert(std::is_standard_layout_v<GateBuffer>);
+static_assert(sizeof(GateOpCode) == 1);
+
+//---------------------------------------------------------------------------//
+// HELPER FUNCTIONS
+//---------------------------------------------------------------------------//
+constexpr BufferedGate buffered_gates[] = {
+    {"ccx__body", GateOpCode::ccx, 0, 3},
+    {"cnot__body", GateOpCode::cnot, 0, 2},
+    {"cx__body", GateOpCode::cx, 0, 2},
+    {"cy__body", GateOpCode::cy, 0, 2},
+    {"cz__body", GateOpCode::cz, 0, 2},
+    {"h__body", GateOpCode::h, 0, 1},
+    {"reset__body", GateOpCode::reset, 0, 1},
+    {"rx__body", GateOpCode::rx, 1, 1},
+    {"rxx__body", GateOpCode::rxx, 1, 2},
+    {"ry__body", GateOpCode::ry, 1, 1},
+    {"ryy__body", GateOpCode::ryy, 1, 2},
+    {"rz__body", GateOpCode::rz, 1, 1},
+    {"rzz__body", GateOpCode::rzz, 1, 2},
+    {"s__adj", GateOpCode::s_adj, 0, 1},
+    {"s__body", GateOpCode::s, 0, 1},
+    {"swap__body", GateOpCode::swap, 0, 2},
+    {"t__adj", GateOpCode::t_adj, 0, 1},
+    {"t__body", GateOpCode::t, 0, 1},
+    {"x__body", GateOpCode::x, 0, 1},
+    {"y__body", GateOpCode::y, 0, 1},
+    {"z__body", GateOpCode::z, 0, 1},
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Whether a declaration has the expected QIS signature.
+ */
+bool has_signature(llvm::Function const& f, BufferedGate const& gate)
+{
+    if (!f.getReturnType()->isVoidTy()
+        || f.arg_size() != gate.num_params + gate.num_qubits)
+    {
+        return false;
+    }
+    for (unsigned i = 0; i < f.arg_size(); ++i)
+    {
+        llvm::Type const* t = f.getArg(i)->getType();
+        if (i < gate.num_params ? !t->isDoubleTy() : !t->isPointerTy())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Generate IR that appends gates to the buffer.
+ */
+class BufferWriter
+{
+  public:
+    explicit BufferWriter(llvm::Module& mod);
+
+    // Define an internal function that buffers a QIS gate
+    llvm::Function* operator()(llvm::Function& decl, BufferedGate const& g);
+
+    // Define an internal function that flushes the buffer before a call
+    llvm::Function* flush_before(llvm::Function& decl);
+
+  private:
+    llvm::Module& mod_;
+    llvm::Type* byte_type_;
+    llvm::Type* int_type_;
+    llvm::PointerType* ptr_type_;
+    llvm::FunctionCallee get_buffer_;
+    llvm::FunctionCallee flush_;
+
+    llvm::Value* field(llvm::IRBuilder<>& b,
+                       llvm::Value* base,
+                       std::size_t offset,
+                       llvm::Type* type);
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Declare the host functions used by the buffered gates.
+ *
+ * The buffer's address is fixed for each thread, so its accessor is marked as
+ * not accessing memory: after inlining, LLVM can hoist it out of loops.
+ * Flushing is rare and marked cold.
+ */
+BufferWriter::BufferWriter(llvm::Module& mod) : mod_{mod}
+{
+    llvm::LLVMContext& ctx = mod.getContext();
+    byte_type_ = llvm::Type::getInt8Ty(ctx);
+    int_type_ = llvm::Type::getIntNTy(ctx, 8 * sizeof(size_type));
+    ptr_type_ = llvm::PointerType::getUnqual(byte_type_);
+    auto* void_type = llvm::Type::getVoidTy(ctx);
+
+    get_buffer_ = mod.getOrInsertFunction(
+        gate_buffer_name, llvm::FunctionType::get(ptr_type_, false));
+    auto* get_buffer = llvm::cast<llvm::Function>(get_buffer_.getCallee());
+    get_buffer->setDoesNotAccessMemory();
+    get_buffer->setDoesNotThrow();
+    get_buffer->setWillReturn();
+
+    flush_ = mod.getOrInsertFunction(flush_gates_name,
+                                     llvm::FunctionType::get(void_type, false));
+    llvm::cast<llvm::Function>(flush_.getCallee())
+        ->addFnAttr(llvm::Attribute::Cold);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Define an internal function that buffers a QIS gate.
+ *
+ * The generated function is equivalent to:
+ * \code
+   void buffered_rx(double theta, Qubit* q)
+   {
+       GateBuffer* buf = __qiree_gate_buffer();
+       size_type i = buf->size;
+       if (i == buf->capacity)
+       {
+           __qiree_flush_gates();
+           i = 0;
+       }
+       GateOp* op = buf->data + i;
+       op->code = GateOpCode::rx;
+       op->params[0] = theta;
+       op->ids[0] = (size_type)q;
+       buf->size = i + 1;
+   }
+ * \endcode
+ */
+llvm::Function*
+BufferWriter::operator()(llvm::Function& decl, BufferedGate const& g)
+{
+    llvm::LLVMContext& ctx = mod_.getContext();
+    auto* f = llvm::Function::Create(decl.getFunctionType(),
+                                     llvm::Function::InternalLinkage,
+                                     "__qiree_buffered_" + std::string{g.name},
+                                     mod_);
+    f->addFnAttr(llvm::Attribute::AlwaysInline);
+
+    auto* entry_block = llvm::BasicBlock::Create(ctx, "entry", f);
+    auto* flush_block = llvm::BasicBlock::Create(ctx, "flush", f);
+    auto* append_block = llvm::BasicBlock::Create(ctx, "append", f);
+    llvm::IRBuilder<> b(entry_block);
+
+    // Check for space in the buffer
+    llvm::Value* buf = b.CreateCall(get_buffer_);
+    llvm::Value* size_ptr
+        = this->field(b, buf, offsetof(GateBuffer, size), int_type_);
+    llvm::Value* size = b.CreateLoad(int_type_, size_ptr, "size");
+    llvm::Value* capacity = b.CreateLoad(
+        int_type_,
+        this->field(b, buf, offsetof(GateBuffer, capacity), int_type_));
+    b.CreateCondBr(
+        b.CreateICmpEQ(size, capacity, "full"), flush_block, append_block);
+
+    b.SetInsertPoint(flush_block);
+    b.CreateCall(flush_);
+    b.CreateBr(append_block);
+
+    // Fill the next operation
+    b.SetInsertPoint(append_block);
+    auto* index = b.CreatePHI(int_type_, 2, "index");
+    index->addIncoming(size, entry_block);
+    index->addIncoming(llvm::ConstantInt::get(int_type_, 0), flush_block);
+    llvm::Value* data = b.CreateLoad(
+        ptr_type_,
+        this->field(b, buf, offsetof(GateBuffer, data), ptr_type_));
+    llvm::Value* op = b.CreateInBoundsGEP(
+        byte_type_,
+        data,
+        b.CreateMul(index, llvm::ConstantInt::get(int_type_, sizeof(GateOp))));
+
+    b.CreateStore(
+        llvm::ConstantInt::get(byte_type_, static_cast<unsigned>(g.code)),
+        this->field(b, op, offsetof(GateOp, code), byte_type_));
+    for (unsigned i = 0; i < g.num_params; ++i)
+    {
+        b.CreateStore(f->getArg(i),
+                      this->field(b,
+                                  op,
+                                  offsetof(GateOp, params) + i * sizeof(double),
+                                  llvm::Type::getDoubleTy(ctx)));
+    }
+    for (unsigned i = 0; i < g.num_qubits; ++i)
+    {
+        std::size_t const offset
+            = offsetof(GateOp, ids) + i * sizeof(size_type);
+        b.CreateStore(
+            b.CreatePtrToInt(f->getArg(g.num_params + i), int_type_),
+            this->field(b, op, offset, int_type_));
+    }
+
+    llvm::Value* next
+        = b.CreateAdd(index, llvm::ConstantInt::get(int_type_, 1), "next");
+    b.CreateStore(next, size_ptr);
+    b.CreateRetVoid();
+    return f;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Define an internal function that flushes the buffer before a call.
+ *
+ * The generated function forwards its arguments and return value to the
+ * declaration after sending any buffered gates to the quantum interface:
+ * \code
+   Result* flushed_m(Qubit* q)
+   {
+       if (__qiree_gate_buffer()->size != 0)
+       {
+           __qiree_flush_gates();
+       }
+       return m(q);
+   }
+ * \endcode
+ */
+llvm::Function* BufferWriter::flush_before(llvm::Function& decl)
+{
+    llvm::LLVMContext& ctx = mod_.getContext();
+    auto* f = llvm::Function::Create(decl.getFunctionType(),
+                                     llvm::Function::InternalLinkage,
+                                     "__qiree_flushed_" + decl.getName(),
+                                     mod_);
+    f->addFnAttr(llvm::Attribute::AlwaysInline);
+
+    auto* entry_block = llvm::BasicBlock::Create(ctx, "entry", f);
+    auto* flush_block = llvm::BasicBlock::Create(ctx, "flush", f);
+    auto* call_block = llvm::BasicBlock::Create(ctx, "call", f);
+    llvm::IRBuilder<> b(entry_block);
+
+    llvm::Value* buf = b.CreateCall(get_buffer_);
+    llvm::Value* size = b.CreateLoad(
+        int_type_,
+        this->field(b, buf, offsetof(GateBuffer, size), int_type_),
+        "size");
+    b.CreateCondBr(
+        b.CreateICmpNE(size, llvm::ConstantInt::get(int_type_, 0), "pending"),
+        flush_block,
+        call_block);
+
+    b.SetInsertPoint(flush_block);
+    b.CreateCall(flush_);
+    b.CreateBr(call_block);
+
+    b.SetInsertPoint(call_block);
+    llvm::SmallVector<llvm::Value*, 4> args;
+    for (llvm::Argument& arg : f->args())
+    {
+        args.push_back(&arg);
+    }
+    llvm::CallInst* result = b.CreateCall(&decl, args);
+    if (result->getType()->isVoidTy())
+    {
+        b.CreateRetVoid();
+    }
+    else
+    {
+        b.CreateRet(result);
+    }
+    return f;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get a typed pointer to a byte offset from a base pointer.
+ */
+llvm::Value* BufferWriter::field(llvm::IRBuilder<>& b,
+                                 llvm::Value* base,
+                                 std::size_t offset,
+                                 llvm::Type* type)
+{
+    llvm::Value* ptr = b.CreateConstInBoundsGEP1_64(byte_type_, base, offset);
+    return b.CreateBitCast(ptr, llvm::PointerType::getUnqual(type));
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Implement QIS gates in IR by appending them to a gate buffer.
+ *
+ * Each used declaration of a single-qubit, two-qubit, or rotation gate on
+ * qubit pointers is replaced by an always-inlined internal function that
+ * appends a \c GateOp to the current thread's \c GateBuffer . The executor
+ * drains the buffer through the quantum interface when it is full and before
+ * any other QIR function reaches the interfaces, so the backend sees the same
+ * sequence of calls.
+ *
+ * Functions named in \c skip (native overrides) are not buffered. Because
+ * they bypass the executor's interfaces, each call to one is instead wrapped
+ * to drain the buffer first. The result is the number of replaced
+ * declarations.
+ */
+size_type add_gate_buffer(llvm::Module& mod, FunctionOverrides const& skip)
+{
+    QIREE_VALIDATE(!mod.getFunction(gate_buffer_name),
+                   << "module already defines '" << gate_buffer_name << "'");
+
+    std::optional<BufferWriter> write;
+    size_type num_replaced = 0;
+    for (BufferedGate const& g : buffered_gates)
+    {
+        std::string const name = std::string{"__quantum__qis__"} + g.name;
+        llvm::Function* decl = mod.getFunction(name);
+        if (!decl || !decl->isDeclaration() || decl->use_empty()
+            || skip.count(name) || !has_signature(*decl, g))
+        {
+            continue;
+        }
+        if (!write)
+        {
+            write.emplace(mod);
+        }
+        llvm::Function* buffered = (*write)(*decl, g);
+        decl->replaceAllUsesWith(buffered);
+        decl->eraseFromParent();
+        ++num_replaced;
+    }
+
+    if (write)
+    {
+        for (auto const& [name, func] : skip)
+        {
+            llvm::Function* decl = mod.getFunction(name);
+            if (!decl || !decl->isDeclaration() || decl->use_empty())
+            {
+                continue;
+            }
+            llvm::Function* flushed = write->flush_before(*decl);
+            decl->replaceUsesWithIf(flushed, [flushed](llvm::Use& u) {
+                auto* inst = llvm::dyn_cast<llvm::Instruction>(u.getUser());
+                return !inst || inst->getFunction() != flushed;
+            });
+        }
+    }
+    return num_replaced;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
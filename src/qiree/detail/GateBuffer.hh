@@ -0,0 +1,50 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/GateBuffer.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include "qiree/Executor.hh"
+#include "qiree/GateTape.hh"
+
+namespace llvm
+{
+class Module;
+}  // namespace llvm
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+//! Name of the function that returns the current thread's gate buffer
+inline constexpr char gate_buffer_name[] = "__qiree_gate_buffer";
+
+//! Name of the function that sends buffered gates to the quantum interface
+inline constexpr char flush_gates_name[] = "__qiree_flush_gates";
+
+//---------------------------------------------------------------------------//
+/*!
+ * Gates appended by compiled code and not yet sent to the backend.
+ *
+ * The layout is shared with the IR generated by \c add_gate_buffer : the
+ * compiled code fills \c data[size] and increments \c size , calling the
+ * flush function first if the buffer is full.
+ */
+struct GateBuffer
+{
+    GateOp* data{nullptr};
+    size_type size{0};
+    size_type capacity{0};
+};
+
+//---------------------------------------------------------------------------//
+// Implement QIS gates in IR by appending them to a gate buffer
+size_type add_gate_buffer(llvm::Module& mod, FunctionOverrides const& skip);
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,134 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/GateDispatch.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include "qiree/Assert.hh"
+#include "qiree/GateTape.hh"
+#include "qiree/QuantumInterface.hh"
+#include "qiree/Span.hh"
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Call the quantum interface function for one recorded operation.
+ *
+ * The interface is a template parameter so that backends can convert a tape
+ * with direct (devirtualized) calls to their \c final member functions.
+ * Overloads taking arrays and tuples are called through the base class since
+ * a backend declaring only the single-qubit overload hides them.
+ */
+template<class Q>
+inline void dispatch_gate(Q& qi,
+                          GateOpCode code,
+                          size_type const* id,
+                          double const* p)
+{
+    QuantumInterface& base = qi;
+    auto q = [id](int i) { return Qubit{id[i]}; };
+    auto a = [id](int i) { return Array{id[i]}; };
+    auto tu = [id](int i) { return Tuple{id[i]}; };
+    auto pauli = [id] { return static_cast<Pauli>(id[0]); };
+
+    switch (code)
+    {
+        // clang-format off
+        case GateOpCode::mz: qi.mz(q(0), Result{id[1]}); break;
+        case GateOpCode::ccx: qi.ccx(q(0), q(1), q(2)); break;
+        case GateOpCode::cnot: qi.cnot(q(0), q(1)); break;
+        case GateOpCode::cx: qi.cx(q(0), q(1)); break;
+        case GateOpCode::cy: qi.cy(q(0), q(1)); break;
+        case GateOpCode::cz: qi.cz(q(0), q(1)); break;
+        case GateOpCode::exp_adj: base.exp_adj(a(0), p[0], a(1)); break;
+        case GateOpCode::exp: base.exp(a(0), p[0], a(1)); break;
+        case GateOpCode::exp_ctl: base.exp(a(0), tu(1)); break;
+        case GateOpCode::exp_ctladj: base.exp_adj(a(0), tu(1)); break;
+        case GateOpCode::h: qi.h(q(0)); break;
+        case GateOpCode::h_ctl: base.h(a(0), q(1)); break;
+        case GateOpCode::r_adj: base.r_adj(pauli(), p[0], q(1)); break;
+        case GateOpCode::r: base.r(pauli(), p[0], q(1)); break;
+        case GateOpCode::r_ctl: base.r(a(0), tu(1)); break;
+        case GateOpCode::r_ctladj: base.r_adj(a(0), tu(1)); break;
+        case GateOpCode::reset: qi.reset(q(0)); break;
+        case GateOpCode::rx: qi.rx(p[0], q(0)); break;
+        case GateOpCode::rx_ctl: base.rx(a(0), tu(1)); break;
+        case GateOpCode::rxx: qi.rxx(p[0], q(0), q(1)); break;
+        case GateOpCode::ry: qi.ry(p[0], q(0)); break;
+        case GateOpCode::ry_ctl: base.ry(a(0), tu(1)); break;
+        case GateOpCode::ryy: qi.ryy(p[0], q(0), q(1)); break;
+        case GateOpCode::rz: qi.rz(p[0], q(0)); break;
+        case GateOpCode::rz_ctl: base.rz(a(0), tu(1)); break;
+        case GateOpCode::rzz: qi.rzz(p[0], q(0), q(1)); break;
+        case GateOpCode::s_adj: qi.s_adj(q(0)); break;
+        case GateOpCode::s: qi.s(q(0)); break;
+        case GateOpCode::s_ctl: base.s(a(0), q(1)); break;
+        case GateOpCode::s_ctladj: base.s_adj(a(0), q(1)); break;
+        case GateOpCode::swap: qi.swap(q(0), q(1)); break;
+        case GateOpCode::t_adj: qi.t_adj(q(0)); break;
+        case GateOpCode::t: qi.t(q(0)); break;
+        case GateOpCode::t_ctl: base.t(a(0), q(1)); break;
+        case GateOpCode::t_ctladj: base.t_adj(a(0), q(1)); break;
+        case GateOpCode::x: qi.x(q(0)); break;
+        case GateOpCode::x_ctl: base.x(a(0), q(1)); break;
+        case GateOpCode::y: qi.y(q(0)); break;
+        case GateOpCode::y_ctl: base.y(a(0), q(1)); break;
+        case GateOpCode::z: qi.z(q(0)); break;
+        case GateOpCode::z_ctl: base.z(a(0), q(1)); break;
+        case GateOpCode::assertmeasurementprobability:
+            base.assertmeasurementprobability(
+                a(0), a(1), Result{id[2]}, p[0], String{id[3]}, p[1]);
+            break;
+        case GateOpCode::assertmeasurementprobability_ctl:
+            base.assertmeasurementprobability(a(0), tu(1));
+            break;
+        // clang-format on
+        default:
+            QIREE_ASSERT_UNREACHABLE();
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Call the quantum interface for every gate in a tape.
+ *
+ * Runtime operations (output recording) are skipped.
+ */
+template<class Q>
+inline void dispatch_gates(GateTape const& tape, Q& qi)
+{
+    for (size_type i = 0, size = tape.size(); i < size; ++i)
+    {
+        GateOpCode const code = tape.code(i);
+        if (!is_runtime(code))
+        {
+            dispatch_gate(qi, code, tape.ids(i), tape.params(i));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Call the quantum interface for every operation in a block of gates.
+ *
+ * The block must not contain runtime operations.
+ */
+template<class Q>
+inline void dispatch_gates(Span<GateOp const> ops, Q& qi)
+{
+    for (GateOp const& op : ops)
+    {
+        QIREE_EXPECT(!is_runtime(op.code));
+        dispatch_gate(qi, op.code, op.ids.data(), op.params.data());
+    }
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,406 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/GatePeephole.cc
+//---------------------------------------------------------------------------//
+#include "GatePeephole.hh"
+
+#include <array>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Module.h>
+
+#include "qiree/Assert.hh"
+
+namespace qiree
+{
+namespace detail
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+// TYPES
+//---------------------------------------------------------------------------//
+//! How a call interacts with the peephole optimizer
+enum class GateKind
+{
+    ignore,  //!< No effect on the quantum state
+    barrier,  //!< May act on any qubit
+    opaque,  //!< Acts on known qubits but cannot be simplified
+    self_inverse,  //!< Applying twice is the identity
+    s,
+    s_adj,
+    t,
+    t_adj,
+    rotation,  //!< Rotation with an angle argument before the qubit
+};
+
+//! Classification of a call
+struct GateInfo
+{
+    GateKind kind{GateKind::barrier};
+    unsigned first_qubit{0};  //!< Index of the first qubit argument
+    unsigned num_qubits{0};  //!< Number of consecutive qubit arguments
+};
+
+//! Call acting on known qubits
+struct Entry
+{
+    llvm::CallBase* call{nullptr};
+    GateInfo info;
+    std::array<size_type, 3> qubits{};
+};
+
+//---------------------------------------------------------------------------//
+// HELPER FUNCTIONS
+//---------------------------------------------------------------------------//
+constexpr llvm::StringLiteral qis_prefix{"__quantum__qis__"};
+
+bool starts_with(llvm::StringRef s, llvm::StringRef prefix)
+{
+    return s.substr(0, prefix.size()) == prefix;
+}
+
+bool ends_with(llvm::StringRef s, llvm::StringRef suffix)
+{
+    return s.size() >= suffix.size()
+           && s.substr(s.size() - suffix.size()) == suffix;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Classify a called function.
+ */
+GateInfo classify(llvm::Function const* f)
+{
+    using K = GateKind;
+    if (!f)
+    {
+        // Indirect call
+        return {K::barrier};
+    }
+    if (f->isIntrinsic())
+    {
+        return {K::ignore};
+    }
+
+    llvm::StringRef name = f->getName();
+    if (starts_with(name, "__quantum__rt__"))
+    {
+        bool no_effect = ends_with(name, "_record_output")
+                         || ends_with(name, "initialize");
+        return {no_effect ? K::ignore : K::barrier};
+    }
+    if (!starts_with(name, qis_prefix))
+    {
+        return {K::barrier};
+    }
+
+    auto [gate, suffix] = name.drop_front(qis_prefix.size()).rsplit("__");
+    if (gate == "read_result")
+    {
+        return {K::ignore};
+    }
+    if (suffix == "adj")
+    {
+        if (gate == "s")
+            return {K::s_adj, 0, 1};
+        if (gate == "t")
+            return {K::t_adj, 0, 1};
+        return {K::barrier};
+    }
+    if (suffix != "body")
+    {
+        return {K::barrier};
+    }
+    if (gate == "h" || gate == "x" || gate == "y" || gate == "z")
+        return {K::self_inverse, 0, 1};
+    if (gate == "cnot" || gate == "cx" || gate == "cy" || gate == "cz"
+        || gate == "swap")
+        return {K::self_inverse, 0, 2};
+    if (gate == "ccx")
+        return {K::self_inverse, 0, 3};
+    if (gate == "s")
+        return {K::s, 0, 1};
+    if (gate == "t")
+        return {K::t, 0, 1};
+    if (gate == "rx" || gate == "ry" || gate == "rz")
+        return {K::rotation, 1, 1};
+    if (gate == "mz" || gate == "m" || gate == "mresetz" || gate == "reset")
+        return {K::opaque, 0, 1};
+    return {K::barrier};
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get a constant qubit index.
+ */
+std::optional<size_type> constant_qubit(llvm::Value const* v)
+{
+    if (llvm::isa<llvm::ConstantPointerNull>(v))
+    {
+        return 0;
+    }
+    if (auto* ce = llvm::dyn_cast<llvm::ConstantExpr>(v);
+        ce && ce->getOpcode() == llvm::Instruction::IntToPtr)
+    {
+        if (auto* ci = llvm::dyn_cast<llvm::ConstantInt>(ce->getOperand(0)))
+        {
+            return ci->getZExtValue();
+        }
+    }
+    return std::nullopt;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Simplify the gates in a single basic block.
+ */
+class BlockSimplifier
+{
+  public:
+    explicit BlockSimplifier(llvm::BasicBlock& bb) : bb_{bb} {}
+
+    // Simplify and return the number of removed calls
+    size_type operator()();
+
+  private:
+    enum class Action
+    {
+        none,  //!< Gates cannot be combined
+        cancel,  //!< Both gates are removed
+        merge,  //!< The second gate is absorbed into the first
+    };
+
+    llvm::BasicBlock& bb_;
+    std::deque<Entry> entries_;
+    std::unordered_map<size_type, std::vector<Entry*>> stacks_;
+    std::vector<llvm::CallBase*> erased_;
+
+    void add(Entry* e);
+    Entry* adjacent(Entry const& e) const;
+    Action combine(Entry& prev, Entry& e);
+    void pop(Entry const& e);
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Simplify and return the number of removed calls.
+ */
+size_type BlockSimplifier::operator()()
+{
+    for (llvm::Instruction& inst : bb_)
+    {
+        auto* call = llvm::dyn_cast<llvm::CallBase>(&inst);
+        if (!call)
+        {
+            continue;
+        }
+
+        GateInfo info = classify(call->getCalledFunction());
+        if (info.kind == GateKind::ignore)
+        {
+            continue;
+        }
+
+        Entry e{call, info, {}};
+        for (unsigned i = 0; i < info.num_qubits; ++i)
+        {
+            unsigned arg = info.first_qubit + i;
+            auto q = arg < call->arg_size()
+                         ? constant_qubit(call->getArgOperand(arg))
+                         : std::nullopt;
+            if (!q)
+            {
+                // Unknown qubit may alias any other
+                e.info.kind = GateKind::barrier;
+                break;
+            }
+            e.qubits[i] = *q;
+        }
+
+        if (e.info.kind == GateKind::barrier)
+        {
+            stacks_.clear();
+            continue;
+        }
+        entries_.push_back(e);
+        this->add(&entries_.back());
+    }
+
+    for (llvm::CallBase* call : erased_)
+    {
+        call->eraseFromParent();
+    }
+    return erased_.size();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Add a gate, combining it with preceding gates where possible.
+ */
+void BlockSimplifier::add(Entry* e)
+{
+    while (Entry* prev = this->adjacent(*e))
+    {
+        Action action = this->combine(*prev, *e);
+        if (action == Action::none)
+        {
+            break;
+        }
+
+        this->pop(*prev);
+        if (action == Action::cancel)
+        {
+            erased_.push_back(prev->call);
+            erased_.push_back(e->call);
+            return;
+        }
+
+        // Try to combine the updated gate with its predecessor
+        erased_.push_back(e->call);
+        e = prev;
+    }
+
+    for (unsigned i = 0; i < e->info.num_qubits; ++i)
+    {
+        stacks_[e->qubits[i]].push_back(e);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the preceding gate acting on exactly the same qubits, if any.
+ */
+Entry* BlockSimplifier::adjacent(Entry const& e) const
+{
+    if (e.info.kind == GateKind::opaque)
+    {
+        return nullptr;
+    }
+
+    Entry* prev = nullptr;
+    for (unsigned i = 0; i < e.info.num_qubits; ++i)
+    {
+        auto iter = stacks_.find(e.qubits[i]);
+        if (iter == stacks_.end() || iter->second.empty())
+        {
+            return nullptr;
+        }
+        Entry* top = iter->second.back();
+        if (prev && top != prev)
+        {
+            return nullptr;
+        }
+        prev = top;
+    }
+    if (!prev || prev->info.num_qubits != e.info.num_qubits
+        || prev->qubits != e.qubits)
+    {
+        return nullptr;
+    }
+    return prev;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Combine two adjacent gates.
+ */
+auto BlockSimplifier::combine(Entry& prev, Entry& e) -> Action
+{
+    using K = GateKind;
+    K const a = prev.info.kind;
+    K const b = e.info.kind;
+    llvm::Function* callee = e.call->getCalledFunction();
+
+    if (a == K::self_inverse && b == K::self_inverse
+        && prev.call->getCalledFunction() == callee)
+    {
+        return Action::cancel;
+    }
+    if ((a == K::s && b == K::s_adj) || (a == K::s_adj && b == K::s)
+        || (a == K::t && b == K::t_adj) || (a == K::t_adj && b == K::t))
+    {
+        return Action::cancel;
+    }
+    if ((a == K::s && b == K::s) || (a == K::s_adj && b == K::s_adj))
+    {
+        // S^2 = Z
+        llvm::Module* mod = bb_.getModule();
+        prev.call->setCalledFunction(mod->getOrInsertFunction(
+            "__quantum__qis__z__body", prev.call->getFunctionType()));
+        prev.info.kind = K::self_inverse;
+        return Action::merge;
+    }
+    if (a == K::rotation && b == K::rotation
+        && prev.call->getCalledFunction() == callee)
+    {
+        auto* theta_a
+            = llvm::dyn_cast<llvm::ConstantFP>(prev.call->getArgOperand(0));
+        auto* theta_b
+            = llvm::dyn_cast<llvm::ConstantFP>(e.call->getArgOperand(0));
+        if (!theta_a || !theta_b)
+        {
+            return Action::none;
+        }
+        double theta = theta_a->getValueAPF().convertToDouble()
+                       + theta_b->getValueAPF().convertToDouble();
+        if (theta == 0)
+        {
+            return Action::cancel;
+        }
+        prev.call->setArgOperand(
+            0, llvm::ConstantFP::get(theta_a->getType(), theta));
+        return Action::merge;
+    }
+    return Action::none;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Remove a gate from the top of its qubits' stacks.
+ */
+void BlockSimplifier::pop(Entry const& e)
+{
+    for (unsigned i = 0; i < e.info.num_qubits; ++i)
+    {
+        auto& stack = stacks_[e.qubits[i]];
+        QIREE_ASSERT(!stack.empty() && stack.back() == &e);
+        stack.pop_back();
+    }
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Simplify gate calls in a function.
+ */
+llvm::PreservedAnalyses
+GatePeepholePass::run(llvm::Function& f, llvm::FunctionAnalysisManager&)
+{
+    size_type num_removed = 0;
+    for (llvm::BasicBlock& bb : f)
+    {
+        num_removed += BlockSimplifier{bb}();
+    }
+    if (num_removed_)
+    {
+        *num_removed_ += num_removed;
+    }
+    return num_removed > 0 ? llvm::PreservedAnalyses::none()
+                           : llvm::PreservedAnalyses::all();
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,57 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/GatePeephole.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <llvm/IR/PassManager.h>
+
+#include "qiree/Types.hh"
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Simplify adjacent quantum gates within each basic block.
+ *
+ * Two gates are adjacent if no other operation acts on their qubits between
+ * them. The pass:
+ * - cancels adjacent self-inverse pairs (\c h , \c x , \c y , \c z ,
+ *   \c cnot , \c cx , \c cy , \c cz , \c swap , \c ccx ) with the same
+ *   operands, and \c s / \c t followed or preceded by its adjoint;
+ * - merges consecutive \c rx , \c ry , or \c rz with constant angles,
+ *   removing both if the total angle is zero;
+ * - replaces \c s twice (or its adjoint twice) with \c z .
+ *
+ * Only gates on constant qubit indices are simplified. Calls to other
+ * functions, except for output recording and \c read_result , act as
+ * barriers on all qubits.
+ */
+class GatePeepholePass : public llvm::PassInfoMixin<GatePeepholePass>
+{
+  public:
+    // Construct with an optional counter of removed gates
+    explicit GatePeepholePass(size_type* num_removed = nullptr)
+        : num_removed_{num_removed}
+    {
+    }
+
+    // Simplify gate calls in a function
+    llvm::PreservedAnalyses
+    run(llvm::Function& f, llvm::FunctionAnalysisManager&);
+
+    //! Run even on functions marked \c optnone
+    static bool isRequired() { return true; }
+
+  private:
+    size_type* num_removed_;
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
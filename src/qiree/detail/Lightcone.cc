@@ -0,0 +1,206 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/Lightcone.cc
+//---------------------------------------------------------------------------//
+#include "Lightcone.hh"
+
+#include <optional>
+#include <vector>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instructions.h>
+
+namespace qiree
+{
+namespace detail
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+constexpr llvm::StringLiteral qis_prefix{"__quantum__qis__"};
+constexpr llvm::StringLiteral rt_prefix{"__quantum__rt__"};
+
+bool starts_with(llvm::StringRef s, llvm::StringRef prefix)
+{
+    return s.substr(0, prefix.size()) == prefix;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get a constant qubit or result index.
+ */
+std::optional<size_type> constant_id(llvm::Value const* v)
+{
+    if (llvm::isa<llvm::ConstantPointerNull>(v))
+    {
+        return 0;
+    }
+    if (auto* ce = llvm::dyn_cast<llvm::ConstantExpr>(v);
+        ce && ce->getOpcode() == llvm::Instruction::IntToPtr)
+    {
+        if (auto* ci = llvm::dyn_cast<llvm::ConstantInt>(ce->getOperand(0)))
+        {
+            return ci->getZExtValue();
+        }
+    }
+    return std::nullopt;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Visit a call in reverse order, returning whether it must be kept.
+ */
+bool visit(llvm::CallBase const& call,
+           Lightcone* lightcone,
+           std::vector<size_type>* qubits)
+{
+    llvm::Function const* f = call.getCalledFunction();
+    if (f && f->isIntrinsic())
+    {
+        return true;
+    }
+    llvm::StringRef name = f ? f->getName() : llvm::StringRef{};
+    auto id = [&call](unsigned i) -> std::optional<size_type> {
+        if (i >= call.arg_size())
+            return std::nullopt;
+        return constant_id(call.getArgOperand(i));
+    };
+
+    if (starts_with(name, rt_prefix))
+    {
+        name = name.drop_front(rt_prefix.size());
+        if (name == "result_record_output")
+        {
+            if (auto r = id(0))
+            {
+                lightcone->record(*r);
+                return true;
+            }
+        }
+        else if (name == "array_record_output"
+                 || name == "tuple_record_output" || name == "initialize")
+        {
+            return true;
+        }
+        lightcone->barrier();
+        return true;
+    }
+    if (!starts_with(name, qis_prefix))
+    {
+        // Indirect call or call to another function
+        lightcone->barrier();
+        return true;
+    }
+
+    auto [gate, suffix] = name.drop_front(qis_prefix.size()).rsplit("__");
+    if (gate == "read_result")
+    {
+        if (auto r = id(0))
+        {
+            lightcone->record(*r);
+            return true;
+        }
+    }
+    else if (gate == "mz")
+    {
+        auto q = id(0);
+        auto r = id(1);
+        if (q && r)
+        {
+            return lightcone->measure(*q, *r);
+        }
+    }
+    else if ((suffix == "body" || suffix == "adj") && gate != "m"
+             && gate != "measure" && gate != "mresetz" && gate != "exp"
+             && !starts_with(gate, "assert"))
+    {
+        // All pointer arguments are qubits
+        qubits->clear();
+        for (unsigned i = 0; i < call.arg_size(); ++i)
+        {
+            if (!call.getArgOperand(i)->getType()->isPointerTy())
+                continue;
+            auto q = id(i);
+            if (!q)
+            {
+                lightcone->barrier();
+                return true;
+            }
+            qubits->push_back(*q);
+        }
+        if (gate == "reset" && qubits->size() == 1)
+        {
+            return lightcone->reset(qubits->front());
+        }
+        return lightcone->gate(qubits->begin(), qubits->end());
+    }
+    lightcone->barrier();
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Remove QIS calls outside the lightcone of the entry point's outputs.
+ *
+ * Starting from the entry point's return, calls are visited backward through
+ * the chain of blocks that unconditionally lead to it. Gates and measurements
+ * on constant qubits that cannot affect a recorded (or read) result are
+ * erased. Calls to other functions, branches into the chain, and operations
+ * on computed or array-valued qubits end the analysis: every earlier call is
+ * kept. The pass is thus most effective after inlining.
+ *
+ * \return Number of erased calls
+ */
+size_type prune_lightcone(llvm::Function& entry)
+{
+    llvm::BasicBlock* bb = nullptr;
+    for (llvm::BasicBlock& b : entry)
+    {
+        if (llvm::isa<llvm::ReturnInst>(b.getTerminator()))
+        {
+            if (bb)
+            {
+                // Multiple exits
+                return 0;
+            }
+            bb = &b;
+        }
+    }
+
+    Lightcone lightcone;
+    std::vector<size_type> qubits;
+    std::vector<llvm::CallBase*> erased;
+    while (bb)
+    {
+        for (auto iter = bb->rbegin(); iter != bb->rend(); ++iter)
+        {
+            auto* call = llvm::dyn_cast<llvm::CallBase>(&*iter);
+            if (call && !visit(*call, &lightcone, &qubits)
+                && call->use_empty())
+            {
+                erased.push_back(call);
+            }
+        }
+
+        // Continue into a predecessor that always branches here
+        llvm::BasicBlock* pred = bb->getSinglePredecessor();
+        bb = (pred && pred != bb && pred->getSingleSuccessor() == bb) ? pred
+                                                                      : nullptr;
+    }
+
+    for (llvm::CallBase* call : erased)
+    {
+        call->eraseFromParent();
+    }
+    return erased.size();
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,112 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/Lightcone.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <unordered_set>
+
+#include "qiree/Types.hh"
+
+namespace llvm
+{
+class Function;
+}  // namespace llvm
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Backward causal lightcone of the recorded results.
+ *
+ * Operations are visited in reverse program order. A qubit is live if a later
+ * kept operation depends on its state, and a result is live if it is recorded
+ * (or read) before being overwritten. Each visit returns whether the
+ * operation is inside the lightcone and must be kept:
+ * - a measurement is kept if its qubit or result is live;
+ * - a reset is kept if its qubit is live, after which the qubit's earlier
+ *   state no longer matters;
+ * - a gate is kept if any of its qubits is live, and makes all of them live.
+ *
+ * Discarding measurements and resets of qubits outside the lightcone is
+ * valid because their (unrecorded) outcomes cannot change the distribution
+ * of the recorded results.
+ *
+ * After a barrier (an operation on unknown qubits or results), every earlier
+ * operation is kept.
+ */
+class Lightcone
+{
+  public:
+    //! Mark a result as observed by the program
+    void record(size_type result)
+    {
+        if (!all_)
+        {
+            results_.insert(result);
+        }
+    }
+
+    //! Visit a measurement of a qubit into a result
+    bool measure(size_type qubit, size_type result)
+    {
+        if (all_)
+            return true;
+        bool keep = results_.erase(result) > 0 || qubits_.count(qubit) > 0;
+        if (keep)
+        {
+            qubits_.insert(qubit);
+        }
+        return keep;
+    }
+
+    //! Visit a reset of a qubit to the zero state
+    bool reset(size_type qubit)
+    {
+        return all_ || qubits_.erase(qubit) > 0;
+    }
+
+    //! Visit a gate acting on a range of qubits
+    template<class Iter>
+    bool gate(Iter first, Iter last)
+    {
+        if (all_)
+            return true;
+        bool keep = false;
+        for (Iter it = first; it != last && !keep; ++it)
+        {
+            keep = qubits_.count(*it) > 0;
+        }
+        if (keep)
+        {
+            qubits_.insert(first, last);
+        }
+        return keep;
+    }
+
+    //! Keep every earlier operation
+    void barrier()
+    {
+        all_ = true;
+        qubits_.clear();
+        results_.clear();
+    }
+
+  private:
+    std::unordered_set<size_type> qubits_;
+    std::unordered_set<size_type> results_;
+    bool all_{false};
+};
+
+//---------------------------------------------------------------------------//
+// Remove QIS calls outside the lightcone of the entry point's outputs
+size_type prune_lightcone(llvm::Function& entry);
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,188 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/Materialize.cc
+//---------------------------------------------------------------------------//
+#include "Materialize.hh"
+
+#include <unordered_set>
+#include <vector>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Error.h>
+
+#include "qiree/Assert.hh"
+
+namespace qiree
+{
+namespace detail
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Throw if materializing failed.
+ */
+void check_error(llvm::Error err, llvm::StringRef what)
+{
+    if (err)
+    {
+        QIREE_VALIDATE(false,
+                       << "failed to load " << std::string_view(what)
+                       << " from bitcode: "
+                       << llvm::toString(std::move(err)));
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Collect functions referenced by a function body.
+ */
+class ReferenceCollector
+{
+  public:
+    explicit ReferenceCollector(std::vector<llvm::Function*>* worklist)
+        : worklist_{worklist}
+    {
+    }
+
+    //! Add all functions referenced by a function's instructions
+    void operator()(llvm::Function& f)
+    {
+        for (llvm::Instruction& inst : llvm::instructions(f))
+        {
+            for (llvm::Value* op : inst.operands())
+            {
+                this->visit(op);
+            }
+        }
+    }
+
+  private:
+    std::vector<llvm::Function*>* worklist_;
+    std::unordered_set<llvm::Value const*> visited_;
+
+    void visit(llvm::Value* v)
+    {
+        if (!llvm::isa<llvm::Constant>(v) || !visited_.insert(v).second)
+        {
+            return;
+        }
+        if (auto* f = llvm::dyn_cast<llvm::Function>(v))
+        {
+            worklist_->push_back(f);
+        }
+        else if (auto* gv = llvm::dyn_cast<llvm::GlobalVariable>(v))
+        {
+            if (gv->hasInitializer())
+            {
+                this->visit(gv->getInitializer());
+            }
+        }
+        else if (auto* c = llvm::dyn_cast<llvm::Constant>(v))
+        {
+            for (llvm::Value* op : c->operands())
+            {
+                this->visit(op);
+            }
+        }
+    }
+};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Load functions in the worklist and everything they reference.
+ */
+void load_worklist(std::vector<llvm::Function*>* worklist)
+{
+    ReferenceCollector collect_references{worklist};
+    while (!worklist->empty())
+    {
+        llvm::Function* f = worklist->back();
+        worklist->pop_back();
+        if (f->isMaterializable())
+        {
+            check_error(f->materialize(), f->getName());
+            collect_references(*f);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Load the bodies of functions reachable from a function.
+ *
+ * This is a null operation unless the module is lazily loaded. Unreachable
+ * functions are left unloaded.
+ */
+void load_reachable(llvm::Function& entry)
+{
+    std::vector<llvm::Function*> worklist{&entry};
+    load_worklist(&worklist);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Load reachable functions and finish loading the module.
+ *
+ * A lazily loaded bitcode module only reads function bodies on demand. This
+ * materializes the entry point and its transitive callees, deletes unused
+ * functions that were never loaded, and then completes the module so that it
+ * can be optimized and compiled. The result is the number of functions
+ * that were discarded without being read.
+ *
+ * Modules that are already fully loaded are unchanged.
+ */
+size_type materialize_reachable(llvm::Module& mod, llvm::Function& entry)
+{
+    if (!mod.getMaterializer())
+    {
+        return 0;
+    }
+
+    size_type num_discarded = 0;
+    std::vector<llvm::Function*> worklist{&entry};
+    do
+    {
+        // Load everything reachable from the worklist
+        load_worklist(&worklist);
+
+        // Remove unreferenced functions; load any that are still used
+        std::vector<llvm::Function*> unused;
+        for (llvm::Function& f : mod)
+        {
+            if (f.isMaterializable())
+            {
+                if (f.use_empty())
+                {
+                    unused.push_back(&f);
+                }
+                else
+                {
+                    worklist.push_back(&f);
+                }
+            }
+        }
+        for (llvm::Function* f : unused)
+        {
+            f->eraseFromParent();
+            ++num_discarded;
+        }
+    } while (!worklist.empty());
+
+    // Load remaining module-level data and release the bitcode
+    check_error(mod.materializeAll(), "module");
+    return num_discarded;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,31 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/Materialize.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include "qiree/Types.hh"
+
+namespace llvm
+{
+class Function;
+class Module;
+}  // namespace llvm
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+// Load the bodies of functions reachable from a function
+void load_reachable(llvm::Function& entry);
+
+// Load reachable functions and finish loading the module
+size_type materialize_reachable(llvm::Module& mod, llvm::Function& entry);
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,207 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/MeasurementFlow.cc
+//---------------------------------------------------------------------------//
+#include "MeasurementFlow.hh"
+
+#include <unordered_set>
+#include <vector>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+
+namespace qiree
+{
+namespace detail
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+constexpr llvm::StringLiteral qis_prefix{"__quantum__qis__"};
+
+//---------------------------------------------------------------------------//
+/*!
+ * Whether a called function returns a measurement outcome.
+ *
+ * The result handles returned by \c m , \c measure , and \c mresetz , as well
+ * as the booleans returned by \c read_result and \c result_equal , depend on
+ * the measurement.
+ */
+bool is_measurement(llvm::StringRef name)
+{
+    return name == "__quantum__qis__m__body"
+           || name == "__quantum__qis__measure__body"
+           || name == "__quantum__qis__mresetz__body"
+           || name == "__quantum__qis__read_result__body"
+           || name == "__quantum__rt__result_equal";
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the functions called directly from the entry point, recursively.
+ */
+std::vector<llvm::Function const*>
+reachable_functions(llvm::Function const& entry)
+{
+    std::vector<llvm::Function const*> result{&entry};
+    std::unordered_set<llvm::Function const*> visited{&entry};
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+        for (llvm::Instruction const& inst : llvm::instructions(*result[i]))
+        {
+            auto* call = llvm::dyn_cast<llvm::CallBase>(&inst);
+            if (!call)
+                continue;
+            llvm::Function const* f = call->getCalledFunction();
+            if (f && !f->isDeclaration() && visited.insert(f).second)
+            {
+                result.push_back(f);
+            }
+        }
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Find uses of measurement outcomes in functions reachable from the entry.
+ *
+ * Starting from each measurement call, this follows def-use chains forward
+ * through instructions, scalar stack variables, arguments of called
+ * functions, and their return values. An outcome passed to \c read_result
+ * or to a runtime function returning a value (e.g., \c result_equal ) taints
+ * the return value; one passed to any other QIS function is a gate argument.
+ * Recording an outcome as output is not a use.
+ *
+ * The function bodies must already be loaded.
+ */
+MeasurementUses find_measurement_uses(llvm::Function const& entry)
+{
+    MeasurementUses result;
+
+    std::vector<llvm::Value const*> worklist;
+    std::unordered_set<llvm::Value const*> visited;
+    auto taint = [&](llvm::Value const* v) {
+        if (visited.insert(v).second)
+        {
+            worklist.push_back(v);
+        }
+    };
+
+    // Find measurements in reachable functions
+    auto const functions = reachable_functions(entry);
+    for (llvm::Function const* f : functions)
+    {
+        for (llvm::Instruction const& inst : llvm::instructions(*f))
+        {
+            auto* call = llvm::dyn_cast<llvm::CallBase>(&inst);
+            llvm::Function const* callee
+                = call ? call->getCalledFunction() : nullptr;
+            if (callee && is_measurement(callee->getName()))
+            {
+                taint(call);
+            }
+        }
+    }
+    std::unordered_set<llvm::Function const*> const is_reachable(
+        functions.begin(), functions.end());
+
+    while (!worklist.empty())
+    {
+        llvm::Value const* v = worklist.back();
+        worklist.pop_back();
+        for (llvm::User const* u : v->users())
+        {
+            if (auto* inst = llvm::dyn_cast<llvm::Instruction>(u);
+                inst && !is_reachable.count(inst->getFunction()))
+            {
+                continue;
+            }
+
+            if (llvm::isa<llvm::BranchInst>(u)
+                || llvm::isa<llvm::IndirectBrInst>(u))
+            {
+                result.branch = true;
+                continue;
+            }
+            if (auto* sw = llvm::dyn_cast<llvm::SwitchInst>(u))
+            {
+                result.branch = result.branch || sw->getCondition() == v;
+                continue;
+            }
+            if (auto* sel = llvm::dyn_cast<llvm::SelectInst>(u);
+                sel && sel->getCondition() == v)
+            {
+                result.branch = true;
+                continue;
+            }
+            if (auto* store = llvm::dyn_cast<llvm::StoreInst>(u))
+            {
+                if (store->getValueOperand() == v)
+                {
+                    for (auto* ptr_user :
+                         store->getPointerOperand()->users())
+                    {
+                        if (llvm::isa<llvm::LoadInst>(ptr_user))
+                            taint(ptr_user);
+                    }
+                }
+                continue;
+            }
+            if (auto* ret = llvm::dyn_cast<llvm::ReturnInst>(u))
+            {
+                for (auto* caller : ret->getFunction()->users())
+                {
+                    if (llvm::isa<llvm::CallBase>(caller))
+                        taint(caller);
+                }
+                continue;
+            }
+            if (auto* call = llvm::dyn_cast<llvm::CallBase>(u))
+            {
+                llvm::Function const* f = call->getCalledFunction();
+                if (!f)
+                {
+                    // Conservatively assume indirect calls are gates
+                    result.gate_argument = true;
+                    continue;
+                }
+                if (!f->isDeclaration())
+                {
+                    for (unsigned i = 0; i < call->arg_size(); ++i)
+                    {
+                        if (call->getArgOperand(i) == v && i < f->arg_size())
+                            taint(f->getArg(i));
+                    }
+                    continue;
+                }
+                if (f->getName().substr(0, qis_prefix.size()) == qis_prefix
+                    && !is_measurement(f->getName()))
+                {
+                    result.gate_argument = true;
+                    continue;
+                }
+            }
+            if (!u->getType()->isVoidTy())
+            {
+                taint(u);
+            }
+        }
+        if (result.branch && result.gate_argument)
+        {
+            break;
+        }
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,35 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/MeasurementFlow.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+namespace llvm
+{
+class Function;
+}  // namespace llvm
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Where measurement outcomes are used by a program.
+ */
+struct MeasurementUses
+{
+    bool branch{false};  //!< An outcome can affect the control flow
+    bool gate_argument{false};  //!< An outcome can be passed to a gate
+};
+
+//---------------------------------------------------------------------------//
+// Find uses of measurement outcomes in functions reachable from the entry
+MeasurementUses find_measurement_uses(llvm::Function const& entry);
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,197 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/Optimizer.cc
+//---------------------------------------------------------------------------//
+#include "Optimizer.hh"
+
+#include <llvm/Analysis/CGSCCPassManager.h>
+#include <llvm/Analysis/LoopAnalysisManager.h>
+#include <llvm/IR/InstrTypes.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/PassManager.h>
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Transforms/IPO/AlwaysInliner.h>
+#include <llvm/Transforms/IPO/GlobalDCE.h>
+#include <llvm/Transforms/IPO/Internalize.h>
+
+#include "GatePeephole.hh"
+#include "Lightcone.hh"
+#include "qiree/Assert.hh"
+
+namespace qiree
+{
+namespace detail
+{
+namespace
+{
+//---------------------------------------------------------------------------//
+llvm::OptimizationLevel to_llvm(OptLevel level)
+{
+    switch (level)
+    {
+        case OptLevel::O0:
+            return llvm::OptimizationLevel::O0;
+        case OptLevel::O1:
+            return llvm::OptimizationLevel::O1;
+        case OptLevel::O2:
+            return llvm::OptimizationLevel::O2;
+        case OptLevel::O3:
+            return llvm::OptimizationLevel::O3;
+    }
+    QIREE_ASSERT_UNREACHABLE();
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Pass builder with registered analyses.
+ */
+struct PassPipeline
+{
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+    llvm::PassBuilder pb;
+
+    PassPipeline()
+    {
+        pb.registerModuleAnalyses(mam);
+        pb.registerCGSCCAnalyses(cgam);
+        pb.registerFunctionAnalyses(fam);
+        pb.registerLoopAnalyses(lam);
+        pb.crossRegisterProxies(lam, fam, cgam, mam);
+    }
+};
+
+//---------------------------------------------------------------------------//
+}  // namespace
+
+//---------------------------------------------------------------------------//
+/*!
+ * Count the instructions and calls in a module.
+ *
+ * Calls to LLVM intrinsics are not counted since they do not leave the JIT
+ * code.
+ */
+void count_instructions(llvm::Module const& mod,
+                        size_type* num_instructions,
+                        size_type* num_calls)
+{
+    QIREE_EXPECT(num_instructions && num_calls);
+
+    *num_instructions = 0;
+    *num_calls = 0;
+    for (llvm::Function const& f : mod)
+    {
+        for (llvm::BasicBlock const& bb : f)
+        {
+            for (llvm::Instruction const& inst : bb)
+            {
+                ++*num_instructions;
+                if (llvm::isa<llvm::CallBase>(inst)
+                    && !llvm::isa<llvm::IntrinsicInst>(inst))
+                {
+                    ++*num_calls;
+                }
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Run the standard LLVM optimization pipeline on a module.
+ *
+ * The per-module default pipeline of the new pass manager includes inlining
+ * of the module's helper functions, sparse conditional constant propagation,
+ * and (for constant trip counts) full loop unrolling. Calls to QIR functions
+ * are opaque to LLVM, so their order and arguments are preserved.
+ *
+ * If requested, adjacent gates exposed by the pipeline are then simplified
+ * with \c GatePeepholePass , and gates that cannot affect the entry point's
+ * recorded outputs are removed with \c prune_lightcone .
+ */
+OptimizationStats optimize(llvm::Module& mod,
+                           llvm::Function& entry,
+                           ExecutorOptions const& options)
+{
+    OptLevel const level = options.opt_level;
+
+    OptimizationStats result;
+    count_instructions(mod, &result.instructions_before, &result.calls_before);
+
+    if (level != OptLevel::O0 || options.simplify_gates)
+    {
+        PassPipeline p;
+        llvm::ModulePassManager mpm;
+        if (level != OptLevel::O0)
+        {
+            mpm = p.pb.buildPerModuleDefaultPipeline(to_llvm(level));
+        }
+        if (options.simplify_gates)
+        {
+            // Simplify gates made adjacent by inlining and unrolling
+            mpm.addPass(llvm::createModuleToFunctionPassAdaptor(
+                GatePeepholePass{&result.gates_removed}));
+        }
+        mpm.run(mod, p.mam);
+    }
+    if (options.prune_lightcone)
+    {
+        result.gates_pruned = prune_lightcone(entry);
+    }
+
+    count_instructions(mod, &result.instructions_after, &result.calls_after);
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Internalize linked library functions and inline calls to them.
+ *
+ * Every definition except the entry point is given internal linkage, which
+ * lets the inliner fold library subroutines into their callers even without
+ * further optimization. Functions that are no longer called are deleted.
+ */
+void inline_linked(llvm::Module& mod, llvm::Function& entry)
+{
+    llvm::internalizeModule(
+        mod, [&entry](llvm::GlobalValue const& gv) { return &gv == &entry; });
+
+    PassPipeline p;
+    llvm::ModulePassManager mpm;
+    mpm.addPass(p.pb.buildInlinerPipeline(llvm::OptimizationLevel::O2,
+                                          llvm::ThinOrFullLTOPhase::None));
+    mpm.addPass(llvm::GlobalDCEPass{});
+    mpm.run(mod, p.mam);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Inline the buffered gate functions and simplify their callers.
+ *
+ * Above \c O0 , the function simplification pipeline then combines the
+ * inlined buffer accesses, e.g. hoisting the buffer lookup out of loops.
+ */
+void inline_gate_buffer(llvm::Module& mod, OptLevel level)
+{
+    PassPipeline p;
+    llvm::ModulePassManager mpm;
+    mpm.addPass(llvm::AlwaysInlinerPass{});
+    if (level != OptLevel::O0)
+    {
+        mpm.addPass(llvm::createModuleToFunctionPassAdaptor(
+            p.pb.buildFunctionSimplificationPipeline(
+                to_llvm(level), llvm::ThinOrFullLTOPhase::None)));
+    }
+    mpm.run(mod, p.mam);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,41 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/Optimizer.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include "qiree/Executor.hh"
+
+namespace llvm
+{
+class Function;
+class Module;
+}  // namespace llvm
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+// Count the instructions and calls in a module
+void count_instructions(llvm::Module const& mod,
+                        size_type* num_instructions,
+                        size_type* num_calls);
+
+// Run the standard LLVM optimization pipeline on a module
+OptimizationStats optimize(llvm::Module& mod,
+                           llvm::Function& entry,
+                           ExecutorOptions const& options);
+
+// Internalize linked library functions and inline calls to them
+void inline_linked(llvm::Module& mod, llvm::Function& entry);
+
+// Inline the buffered gate functions and simplify their callers
+void inline_gate_buffer(llvm::Module& mod, OptLevel level);
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,45 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/ResultHandle.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <cstdint>
+
+#include "qiree/Types.hh"
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Handles of the constant results returned by the runtime.
+ *
+ * Results are indices into the backend's classical register, so reading or
+ * comparing one is a constant-time lookup that never allocates. The constant
+ * zero and one results are reserved at the top of the index range and must
+ * never be passed to a backend.
+ */
+constexpr std::uintptr_t one_result{~std::uintptr_t{0}};
+constexpr std::uintptr_t zero_result{one_result - 1};
+
+//---------------------------------------------------------------------------//
+//! Whether a result handle is one of the constant results
+inline constexpr bool is_constant_result(std::uintptr_t r)
+{
+    return r >= zero_result;
+}
+
+//! Value of a constant result handle
+inline constexpr QState constant_result(std::uintptr_t r)
+{
+    return r == one_result ? QState::one : QState::zero;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,94 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/ShotLoop.cc
+//---------------------------------------------------------------------------//
+#include "ShotLoop.hh"
+
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+
+#include "qiree/Assert.hh"
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Add a function that calls the entry point once per shot.
+ *
+ * The generated function is equivalent to:
+ * \code
+   void __qiree_shot_loop(uint64_t num_shots)
+   {
+       for (uint64_t i = 0; i != num_shots; ++i)
+       {
+           __qiree_begin_shot();
+           entry();
+           __qiree_end_shot(i);
+       }
+   }
+ * \endcode
+ * so that running many shots costs two direct calls per shot beyond the
+ * program itself. The begin and end functions are bound by the executor.
+ */
+llvm::Function* add_shot_loop(llvm::Module& mod, llvm::Function& entry)
+{
+    QIREE_EXPECT(entry.arg_empty());
+    QIREE_VALIDATE(!mod.getFunction(shot_loop_name),
+                   << "module already defines '" << shot_loop_name << "'");
+
+    llvm::LLVMContext& ctx = mod.getContext();
+    auto* void_type = llvm::Type::getVoidTy(ctx);
+    auto* int_type = llvm::Type::getInt64Ty(ctx);
+
+    auto begin_shot = mod.getOrInsertFunction(
+        begin_shot_name, llvm::FunctionType::get(void_type, false));
+    auto end_shot = mod.getOrInsertFunction(
+        end_shot_name, llvm::FunctionType::get(void_type, {int_type}, false));
+
+    auto* loop = llvm::Function::Create(
+        llvm::FunctionType::get(void_type, {int_type}, false),
+        llvm::Function::ExternalLinkage,
+        shot_loop_name,
+        mod);
+    llvm::Value* num_shots = loop->getArg(0);
+
+    auto* entry_block = llvm::BasicBlock::Create(ctx, "entry", loop);
+    auto* body_block = llvm::BasicBlock::Create(ctx, "shot", loop);
+    auto* exit_block = llvm::BasicBlock::Create(ctx, "exit", loop);
+    llvm::IRBuilder<> builder(entry_block);
+
+    // Skip the loop entirely for zero shots
+    auto* zero = llvm::ConstantInt::get(int_type, 0);
+    builder.CreateCondBr(
+        builder.CreateICmpEQ(num_shots, zero), exit_block, body_block);
+
+    // Call the entry point between the begin/end hooks
+    builder.SetInsertPoint(body_block);
+    auto* shot = builder.CreatePHI(int_type, 2, "shot");
+    shot->addIncoming(zero, entry_block);
+    builder.CreateCall(begin_shot);
+    builder.CreateCall(entry.getFunctionType(), &entry);
+    builder.CreateCall(end_shot, {shot});
+    auto* next = builder.CreateAdd(
+        shot, llvm::ConstantInt::get(int_type, 1), "next");
+    shot->addIncoming(next, body_block);
+    builder.CreateCondBr(
+        builder.CreateICmpEQ(next, num_shots), exit_block, body_block);
+
+    builder.SetInsertPoint(exit_block);
+    builder.CreateRetVoid();
+
+    return loop;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,36 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/ShotLoop.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+namespace llvm
+{
+class Function;
+class Module;
+}  // namespace llvm
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+//! Name of the function called at the start of each shot in the loop
+inline constexpr char begin_shot_name[] = "__qiree_begin_shot";
+
+//! Name of the function called at the end of each shot in the loop
+inline constexpr char end_shot_name[] = "__qiree_end_shot";
+
+//! Name of the synthesized shot loop
+inline constexpr char shot_loop_name[] = "__qiree_shot_loop";
+
+//---------------------------------------------------------------------------//
+// Add a function that calls the entry point once per shot
+llvm::Function* add_shot_loop(llvm::Module& mod, llvm::Function& entry);
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
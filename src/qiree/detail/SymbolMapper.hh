@@ -0,0 +1,111 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/detail/SymbolMapper.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <type_traits>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/Orc/Core.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+
+#include "FunctionChecker.hh"
+#include "qiree/Assert.hh"
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Collect absolute symbol definitions for an ORC JIT.
+ *
+ * This is the ORC counterpart to \c GlobalMapper: rather than patching the
+ * execution engine's global table, it builds a symbol map that is defined in
+ * the JIT's main library with \c llvm::orc::absoluteSymbols .
+ */
+class SymbolMapper
+{
+  public:
+    // Construct with module and JIT
+    inline SymbolMapper(llvm::Module const& mod, llvm::orc::LLJIT& jit);
+
+    // Map a symbol name to a compiled function pointer
+    template<class F>
+    inline void operator()(char const* name, F* func);
+
+    // Define all mapped symbols in the JIT's main library
+    inline void define();
+
+  private:
+    llvm::Module const& mod_;
+    llvm::orc::LLJIT& jit_;
+    llvm::orc::SymbolMap symbols_;
+};
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Construct with module and JIT.
+ */
+SymbolMapper::SymbolMapper(llvm::Module const& mod, llvm::orc::LLJIT& jit)
+    : mod_{mod}, jit_{jit}
+{
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Map a symbol name to a compiled function pointer.
+ */
+template<class F>
+void SymbolMapper::operator()(char const* name, F* func)
+{
+    static_assert(std::is_function_v<F>, "not a function");
+
+    llvm::Function* irfunc = mod_.getFunction(name);
+    if (!irfunc)
+    {
+        // Function isn't available in the module (i.e. used by the current QIR
+        // file)
+        return;
+    }
+
+    // Throw an assertion if the function types don't match
+    FunctionChecker{*irfunc}(func);
+
+    auto flags = llvm::JITSymbolFlags::Exported
+                 | llvm::JITSymbolFlags::Callable;
+#if LLVM_VERSION_MAJOR >= 17
+    symbols_[jit_.mangleAndIntern(name)]
+        = {llvm::orc::ExecutorAddr::fromPtr(func), flags};
+#else
+    symbols_[jit_.mangleAndIntern(name)] = llvm::JITEvaluatedSymbol(
+        llvm::pointerToJITTargetAddress(func), flags);
+#endif
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Define all mapped symbols in the JIT's main library.
+ */
+void SymbolMapper::define()
+{
+    if (auto err = jit_.getMainJITDylib().define(
+            llvm::orc::absoluteSymbols(std::move(symbols_))))
+    {
+        QIREE_VALIDATE(false,
+                       << "failed to define QIR symbols: "
+                       << llvm::toString(std::move(err)));
+    }
+    symbols_.clear();
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -18,6 +18,8 @@
 #include <dlfcn.h>
 
 #include "qiree/Assert.hh"
+#include "qiree/GateTape.hh"
+#include "qiree/detail/GateDispatch.hh"
 
 extern "C" Catalyst::Runtime::QuantumDevice*
 GenericDeviceFactory(char const* kwargs);
@@ -30,7 +32,7 @@ using namespace Catalyst::Runtime;
  * Initialize the Lightning simulator
  */
 LightningQuantum::LightningQuantum(std::ostream& os, unsigned long int seed)
-    : output_(os), seed_(seed)
+    : output_(os), seed_(seed), reset_rng_(seed)
 {
     auto rtld_flags = RTLD_LAZY | RTLD_NODELETE;
     rtd_dylib_handler_ = dlopen(QIREE_LIGHTNING_RTDLIB, rtld_flags);
@@ -96,11 +98,23 @@ void LightningQuantum::tear_down() {}
 
 //---------------------------------------------------------------------------//
 /*!
- * Reset the qubit
+ * Reset the qubit to the zero state.
+ *
+ * The qubit is measured and flipped if the outcome is one. The measurement is
+ * seeded from a separate generator so that resets do not change the seeds of
+ * later \c mz calls.
  */
 void LightningQuantum::reset(Qubit q)
 {
-    q.value = 0;
+    QIREE_EXPECT(q.value < this->num_qubits());
+    std::mt19937 gen(reset_rng_());
+    rtd_qdevice_->SetDevicePRNG(&gen);
+    auto result
+        = rtd_qdevice_->Measure(static_cast<intptr_t>(q.value), std::nullopt);
+    if (*result)
+    {
+        this->x(q);
+    }
 }
 
 //----------------------------------------------------------------------------//
@@ -204,4 +218,16 @@ void LightningQuantum::rz(double theta, Qubit q)
         "RZ", {theta}, {static_cast<intptr_t>(q.value)});
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * Apply a block of gates with direct calls.
+ *
+ * The device has no batched entry point, so this only avoids the virtual
+ * call for each gate.
+ */
+void LightningQuantum::apply(Span<GateOp const> ops)
+{
+    detail::dispatch_gates(ops, *this);
+}
+
 }  // namespace qiree
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <ostream>
+#include <random>
 #include <vector>
 
 #include "qiree/Assert.hh"
@@ -86,6 +87,9 @@ class LightningQuantum final : virtual public QuantumNotImpl
     void z(Qubit) final;
     //!@}
 
+    // Apply a block of gates with direct calls
+    void apply(Span<GateOp const> ops) final;
+
   private:
     //// TYPES ////
 
@@ -96,6 +100,7 @@ class LightningQuantum final : virtual public QuantumNotImpl
 
     std::ostream& output_;
     unsigned long int seed_{};
+    std::mt19937 reset_rng_;  //!< Seeds for measurements done by resets
     void* rtd_dylib_handler_;
     void* factory_f_ptr_;
     std::unique_ptr<Catalyst::Runtime::QuantumDevice> rtd_qdevice_;
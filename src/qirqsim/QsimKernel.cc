@@ -0,0 +1,117 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qirqsim/QsimKernel.cc
+//---------------------------------------------------------------------------//
+#include "QsimKernel.hh"
+
+#include "qiree/Assert.hh"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define QIRQSIM_CPU_SUPPORTS(FEATURE) __builtin_cpu_supports(FEATURE)
+#else
+#    define QIRQSIM_CPU_SUPPORTS(FEATURE) false
+#endif
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Get a string corresponding to a qsim kernel.
+ */
+char const* to_cstring(QsimKernel value)
+{
+    switch (value)
+    {
+        case QsimKernel::automatic:
+            return "auto";
+        case QsimKernel::basic:
+            return "basic";
+        case QsimKernel::sse:
+            return "sse";
+        case QsimKernel::avx2:
+            return "avx2";
+        case QsimKernel::avx512:
+            return "avx512";
+    }
+    return "";
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get a qsim kernel from a string.
+ */
+QsimKernel to_qsim_kernel(std::string const& s)
+{
+    for (auto k : {QsimKernel::automatic,
+                   QsimKernel::basic,
+                   QsimKernel::sse,
+                   QsimKernel::avx2,
+                   QsimKernel::avx512})
+    {
+        if (s == to_cstring(k))
+        {
+            return k;
+        }
+    }
+    QIREE_VALIDATE(false, << "invalid qsim kernel '" << s << "'");
+    return {};
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Whether a kernel was compiled and is supported by this CPU.
+ *
+ * The CPU features (and the operating system's support for saving the wide
+ * registers) are queried at run time, so a single binary can select the
+ * fastest kernel on each machine.
+ */
+bool is_available(QsimKernel value)
+{
+    switch (value)
+    {
+        case QsimKernel::automatic:
+        case QsimKernel::basic:
+            return true;
+        case QsimKernel::sse:
+#if QIRQSIM_HAVE_SSE
+            return QIRQSIM_CPU_SUPPORTS("sse4.1");
+#else
+            return false;
+#endif
+        case QsimKernel::avx2:
+#if QIRQSIM_HAVE_AVX2
+            return QIRQSIM_CPU_SUPPORTS("avx2") && QIRQSIM_CPU_SUPPORTS("fma");
+#else
+            return false;
+#endif
+        case QsimKernel::avx512:
+#if QIRQSIM_HAVE_AVX512
+            return QIRQSIM_CPU_SUPPORTS("avx512f");
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Get the fastest available kernel.
+ */
+QsimKernel best_qsim_kernel()
+{
+    for (auto k : {QsimKernel::avx512, QsimKernel::avx2, QsimKernel::sse})
+    {
+        if (is_available(k))
+        {
+            return k;
+        }
+    }
+    return QsimKernel::basic;
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
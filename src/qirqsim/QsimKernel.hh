@@ -0,0 +1,48 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qirqsim/QsimKernel.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <string>
+
+namespace qiree
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Vectorized qsim simulator used to apply gates.
+ *
+ * Each SIMD kernel is compiled separately with the instruction set it needs,
+ * and the fastest one supported by the CPU is chosen at run time. A specific
+ * kernel can be forced (e.g., for benchmarking) if the build and CPU support
+ * it.
+ */
+enum class QsimKernel
+{
+    automatic,  //!< Fastest available kernel
+    basic,  //!< Portable scalar simulator (\c SimulatorBasic)
+    sse,  //!< SSE4.1 (\c SimulatorSSE)
+    avx2,  //!< AVX2 and FMA (\c SimulatorAVX)
+    avx512,  //!< AVX-512F (\c SimulatorAVX512)
+};
+
+//---------------------------------------------------------------------------//
+// FREE FUNCTIONS
+//---------------------------------------------------------------------------//
+// Get a string corresponding to a qsim kernel
+char const* to_cstring(QsimKernel value);
+
+// Get a qsim kernel from a string
+QsimKernel to_qsim_kernel(std::string const& s);
+
+// Whether a kernel was compiled and is supported by this CPU
+bool is_available(QsimKernel value);
+
+// Get the fastest available kernel
+QsimKernel best_qsim_kernel();
+
+//---------------------------------------------------------------------------//
+}  // namespace qiree
@@ -11,63 +11,73 @@
 #include <algorithm>
 #include <iostream>
 #include <optional>
+#include <random>
 #include <stdexcept>
 #include <thread>
 #include <utility>
 
 #include "qiree/Assert.hh"
+#include "qiree/Executor.hh"
+#include "qiree/GateTape.hh"
+#include "qiree/SingleResultRuntime.hh"
+#include "qiree/detail/EndGuard.hh"
+#include "qiree/detail/GateDispatch.hh"
+
+#include "detail/QsimEngine.hh"
 
 // Qsim
 #include <qsim/lib/circuit.h>
-#include <qsim/lib/circuit_qsim_parser.h>
-#include <qsim/lib/formux.h>
-#include <qsim/lib/fuser.h>
 #include <qsim/lib/fuser_mqubit.h>
-#include <qsim/lib/gate.h>
 #include <qsim/lib/gates_qsim.h>
 #include <qsim/lib/io.h>
-#include <qsim/lib/io_file.h>
-#include <qsim/lib/run_qsim.h>
-#include <qsim/lib/simmux.h>
-#include <qsim/lib/simulator_basic.h>
-#include <qsim/lib/statespace_basic.h>
-#include <qsim/lib/util_cpu.h>
 //
 
 namespace qiree
 {
 //---------------------------------------------------------------------------//
 /*!
- * Factory class for creating simulators in qsim.
- */
-struct QsimQuantum::Factory
-{
-    Factory(unsigned num_threads) : num_threads(num_threads) {}
-    using Simulator = qsim::Simulator<qsim::For>;
-    using StateSpace = Simulator::StateSpace;
-
-    StateSpace CreateStateSpace() const { return StateSpace(num_threads); }
-    Simulator CreateSimulator() const { return Simulator(num_threads); }
-    unsigned num_threads;
-};
-
-//---------------------------------------------------------------------------//
-/*!
- * Quantum state and circuit.
+ * Persistent simulator, quantum state, and pending gates.
+ *
+ * The simulator and state vector are kept alive across measurements and
+ * shots, and the pending gate storage keeps its capacity after it is
+ * applied.
  */
 struct QsimQuantum::State
 {
-    qsim::Circuit<qsim::GateQSim<float>> circuit;
-    std::optional<Factory::StateSpace::State> state;
+    using Gate = detail::QsimEngine::Gate;
+    using Fuser = qsim::MultiQubitGateFuser<qsim::IO, Gate>;
+
+    std::unique_ptr<detail::QsimEngine> engine;
+    qsim::Circuit<Gate> circuit;  //!< Gates not yet applied to the state
+    std::mt19937 reset_rng;  //!< Seeds for measurements done by resets
 };
 
 //---------------------------------------------------------------------------//
 /*!
- * Initialize the qsim simulator
+ * Initialize the qsim simulator.
+ *
+ * If the number of threads is zero, the hardware concurrency is used. When
+ * several simulators run shots in parallel, each should be given a share of
+ * the available threads. The automatic kernel selects the fastest SIMD
+ * simulator supported by the CPU.
  */
-QsimQuantum::QsimQuantum(std::ostream& os, unsigned long int seed)
-    : output_(os), seed_(seed), state_{std::make_unique<State>()}
+QsimQuantum::QsimQuantum(std::ostream& os,
+                         unsigned long int seed,
+                         unsigned int num_threads,
+                         QsimKernel kernel)
+    : output_(os)
+    , seed_(seed)
+    , state_{std::make_unique<State>()}
+    , num_threads_{num_threads}
+    , kernel_{kernel == QsimKernel::automatic ? best_qsim_kernel() : kernel}
 {
+    if (num_threads_ == 0)
+    {
+        num_threads_ = std::max(
+            1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    state_->engine = detail::make_qsim_engine(kernel_, num_threads_);
+    state_->reset_rng.seed(seed);
 }
 
 //---------------------------------------------------------------------------//
@@ -88,22 +98,14 @@ void QsimQuantum::set_up(EntryPointAttrs const& attrs)
     // (probably not true in general)
     results_.resize(attrs.required_num_results);
     num_qubits_ = attrs.required_num_qubits;
-    num_threads_
-        = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
-
-    // Initialize the qsim simulator
-    auto state_space = Factory(num_threads_).CreateStateSpace();
-
-    // Create the state
-    state_->state = state_space.Create(this->num_qubits());
-    // Check if the state is null
-    QIREE_VALIDATE(!state_space.IsNull(*state_->state),
-                   << "not enough memory: is the number of qubits too large?");
 
+    // Reuse the state vector from the previous execution if possible
     // TODO: initial states shouldn't necessarily be zero
-    state_space.SetStateZero(*state_->state);
+    QIREE_VALIDATE(state_->engine->set_zero(num_qubits_),
+                   << "not enough memory: is the number of qubits too large?");
 
     // Allocate the number of qubits in the circuit
+    state_->circuit.gates.clear();
     state_->circuit.num_qubits = num_qubits_;
     gate_index_ = 0;
 }
@@ -111,19 +113,30 @@ void QsimQuantum::set_up(EntryPointAttrs const& attrs)
 //---------------------------------------------------------------------------//
 /*!
  * Complete an execution.
+ *
+ * Unapplied gates are discarded, but the simulator and state are kept for
+ * the next execution.
  */
 void QsimQuantum::tear_down()
 {
-    state_->circuit = {};
+    state_->circuit.gates.clear();
 }
 
 //---------------------------------------------------------------------------//
 /*!
- * Reset the qubit
+ * Reset the qubit to the zero state.
+ *
+ * The qubit is measured and flipped if the outcome is one. The measurement
+ * is seeded from a separate generator so that resets do not shift the seeds
+ * of later \c mz outcomes.
  */
 void QsimQuantum::reset(Qubit q)
 {
-    q.value = 0;
+    QIREE_EXPECT(q.value < this->num_qubits());
+    if (this->measure(q, state_->reset_rng()))
+    {
+        this->x(q);
+    }
 }
 
 //---------------------------------------------------------------------------//
@@ -138,50 +151,7 @@ void QsimQuantum::mz(Qubit q, Result r)
     QIREE_EXPECT(q.value < this->num_qubits());
     QIREE_EXPECT(r.value < this->num_results());
 
-    // Add measurement instruction
-    state_->circuit.gates.push_back(
-        qsim::gate::Measurement<qsim::GateQSim<float>>::Create(
-            gate_index_++, {static_cast<unsigned int>(q.value)}));
-
-    //// EXECUTE CIRCUIT ////
-
-    using Fuser = qsim::MultiQubitGateFuser<qsim::IO, qsim::GateQSim<float>>;
-    using Runner = qsim::QSimRunner<qsim::IO, Fuser, Factory>;
-    using StateSpace = Factory::StateSpace;
-
-    // Vector to hold measurement results, this must be empty before running
-    std::vector<StateSpace::MeasurementResult> meas_results;
-    std::string stringResult;
-
-    Runner::Parameter qsimParam;  // Parameters for qsim
-    qsimParam.seed = seed_;
-    seed_++;
-    qsimParam.max_fused_size = 2;  // Set the maximum size of fused gates
-    qsimParam.verbosity = 0;  // see verbosity in run_qsim.h
-
-    // Run the simulation and check that it passed
-    bool const run_success = Runner::Run(qsimParam,
-                                         Factory(num_threads_),
-                                         state_->circuit,
-                                         *state_->state,
-                                         meas_results);
-    QIREE_ASSERT(run_success);
-    QIREE_VALIDATE(
-        meas_results.size() == 1 && meas_results[0].bitstring.size() == 1,
-        << "inconsistent measured results size (" << meas_results.size()
-        << "), bitstring size");
-
-    //// RESET CIRCUIT ////
-
-    state_->circuit = {};
-    state_->circuit.num_qubits = num_qubits_;
-
-    //// STORE RESULT ////
-
-    auto result = meas_results[0].bitstring[0];
-    QIREE_ASSERT(result == 0 || result == 1);
-
-    results_[r.value] = result;
+    results_[r.value] = this->measure(q, static_cast<unsigned int>(seed_++));
 }
 
 //----------------------------------------------------------------------------//
@@ -255,13 +225,165 @@ void QsimQuantum::rz(double theta, Qubit q)
     this->add_gate<qsim::GateRZ>(q.value, theta);
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * Add the gates of a recorded tape to the qsim circuit.
+ *
+ * Gates are converted with direct calls to this class rather than through the
+ * quantum interface, and the circuit storage is reserved up front.
+ * Measurements run the pending circuit as with \c mz . Runtime output
+ * operations in the tape are ignored.
+ */
+void QsimQuantum::apply(GateTape const& tape)
+{
+    auto& gates = state_->circuit.gates;
+    gates.reserve(gates.size() + tape.size());
+    detail::dispatch_gates(tape, *this);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Add a block of gates to the qsim circuit.
+ *
+ * The gates are appended with direct calls to this class. Blocks are small
+ * and arrive many times per shot, so the circuit storage grows as usual
+ * rather than being reserved for each block. Measurements apply the pending
+ * gates as with \c mz .
+ */
+void QsimQuantum::apply(Span<GateOp const> ops)
+{
+    detail::dispatch_gates(ops, *this);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Record one execution of a program without simulating it.
+ *
+ * Gates are neither stored nor applied and measurements read zero, so
+ * recording costs little more than the calls into the program. A program
+ * that reads a measured result is reported as not replayable, so the zeros
+ * never affect a tape that is used.
+ */
+bool QsimQuantum::record(Executor const& execute,
+                         RuntimeInterface& rt,
+                         GateTape* tape)
+{
+    QIREE_EXPECT(!sampled_state_);
+    detail::EndGuard on_end_scope_([this] { sampled_state_.reset(); });
+    sampled_state_ = 0;
+    return execute.record(*this, rt, tape);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Simulate gates once and sample their terminal measurements.
+ *
+ * The gates and outputs are split from a recorded tape with
+ * \c split_terminal_measurements . The final state of the gates is simulated
+ * once, and basis states for all shots are sampled from its amplitudes. The
+ * outputs are then replayed through the runtime once for each distinct
+ * sampled state, with measurements reading the sampled bits.
+ */
+ResultDistribution QsimQuantum::sample(EntryPointAttrs const& attrs,
+                                       GateTape const& gates,
+                                       GateTape const& outputs,
+                                       SingleResultRuntime& rt,
+                                       size_type num_shots)
+{
+    QIREE_EXPECT(num_shots > 0);
+    QIREE_VALIDATE(attrs.required_num_qubits <= 64,
+                   << "cannot sample more than 64 qubits");
+
+    detail::EndGuard on_end_scope_([this] {
+        sampled_state_.reset();
+        this->tear_down();
+    });
+    this->set_up(attrs);
+    this->apply(gates);
+    this->apply_pending();
+
+    std::vector<std::uint64_t> samples = state_->engine->sample(
+        num_shots, static_cast<unsigned int>(seed_++));
+    QIREE_VALIDATE(samples.size() == num_shots,
+                   << "failed to sample " << num_shots << " shots");
+    std::sort(samples.begin(), samples.end());
+
+    ResultDistribution result;
+    for (auto iter = samples.begin(); iter != samples.end();)
+    {
+        auto next = std::upper_bound(iter, samples.end(), *iter);
+        sampled_state_ = *iter;
+        ::qiree::replay(outputs, *this, rt);
+        result.accumulate(rt.result(), next - iter);
+        iter = next;
+    }
+    return result;
+}
+
 //----------------------------------------------------------------------------//
 // PRIVATE HELPERS
+//----------------------------------------------------------------------------//
+/*!
+ * Apply the pending gates to the state.
+ *
+ * Gates are fused into blocks of at most \c max_fused_size qubits before
+ * they are applied. The gate storage is cleared but keeps its capacity.
+ */
+void QsimQuantum::apply_pending()
+{
+    auto& gates = state_->circuit.gates;
+    if (gates.empty())
+    {
+        return;
+    }
+
+    State::Fuser::Parameter param;
+    param.max_fused_size = max_fused_size;
+    param.verbosity = 0;  // see verbosity in run_qsim.h
+
+    auto const fused = State::Fuser::FuseGates(param, num_qubits_, gates);
+    QIREE_ASSERT(!fused.empty());
+    state_->engine->apply(fused);
+    gates.clear();
+}
+
+//----------------------------------------------------------------------------//
+/*!
+ * Measure one qubit in place.
+ *
+ * Pending gates are applied first, and the state is collapsed afterward with
+ * a generator created from the given seed. Measurements by \c mz take the
+ * next value of the seed counter, as when every measurement ran the pending
+ * circuit through qsim's runner, so outcomes are independent of how the
+ * gates were batched.
+ *
+ * While sampling, the outcome is read from the sampled basis state and
+ * nothing is simulated.
+ */
+bool QsimQuantum::measure(Qubit q, unsigned int seed)
+{
+    if (sampled_state_)
+    {
+        return (*sampled_state_ >> q.value) & 1;
+    }
+    this->apply_pending();
+    bool outcome{false};
+    QIREE_VALIDATE(state_->engine->measure(
+                       static_cast<unsigned int>(q.value), seed, &outcome),
+                   << "invalid measurement of qubit " << q.value);
+    return outcome;
+}
+
 //----------------------------------------------------------------------------//
 //! Create a gate and add it to the circuit
 template<template<class> class Gate, class... Ts>
 void QsimQuantum::add_gate(Ts&&... args)
 {
+    if (sampled_state_)
+    {
+        // Not simulating: gates would be discarded unapplied
+        return;
+    }
     state_->circuit.gates.push_back(
         Gate<float>::Create(gate_index_++, std::forward<Ts>(args)...));
 }
@@ -7,27 +7,64 @@
 //---------------------------------------------------------------------------//
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <vector>
 
 #include "qiree/Assert.hh"
 #include "qiree/Macros.hh"
 #include "qiree/QuantumNotImpl.hh"
+#include "qiree/ResultDistribution.hh"
 #include "qiree/RuntimeInterface.hh"
 #include "qiree/Types.hh"
 
+#include "QsimKernel.hh"
+
 namespace qiree
 {
+//---------------------------------------------------------------------------//
+class Executor;
+class GateTape;
+class SingleResultRuntime;
+
 //---------------------------------------------------------------------------//
 /*!
  * Create and execute quantum circuits using google Qsim.
+ *
+ * Gates are accumulated until a measurement, when they are fused and applied
+ * to a persistent state vector. The measurement is then done in place, so
+ * programs with many mid-circuit measurements do not rebuild the simulator or
+ * reallocate the circuit. The state vector is reused across executions with
+ * the same number of qubits. Each measurement draws from a generator seeded
+ * with the next value of a counter that starts at the construction seed, so
+ * outcomes match those of running each measured circuit through qsim.
+ *
+ * Gates are applied with a SIMD kernel chosen at run time (see
+ * \c QsimKernel ), so one binary runs the fastest simulator on each CPU.
+ *
+ * Circuits whose measurements are all terminal can instead be simulated once
+ * and sampled for every shot with \c sample . The program is first recorded
+ * with \c record , which does not simulate anything:
+ * \code
+   GateTape tape, gates, outputs;
+   if (sim.record(execute, rt, &tape)
+       && split_terminal_measurements(tape, &gates, &outputs))
+   {
+       distribution = sim.sample(
+           execute.entry_point_attrs(), gates, outputs, rt, num_shots);
+   }
+ * \endcode
  */
 class QsimQuantum final : virtual public QuantumNotImpl
 {
   public:
-    // Construct with number of shots
-    QsimQuantum(std::ostream& os, unsigned long int seed);
+    // Construct with seed, number of simulator threads, and SIMD kernel
+    QsimQuantum(std::ostream& os,
+                unsigned long int seed,
+                unsigned int num_threads = 0,
+                QsimKernel kernel = QsimKernel::automatic);
     ~QsimQuantum();
 
     QIREE_DELETE_COPY_MOVE(QsimQuantum);  // Delete copy and move constructors
@@ -41,6 +78,9 @@ class QsimQuantum final : virtual public QuantumNotImpl
     //! Number of classical result registers
     size_type num_results() const { return results_.size(); }
 
+    //! SIMD kernel used to apply gates
+    QsimKernel kernel() const { return kernel_; }
+
     //!@}
 
     //!@{
@@ -82,12 +122,32 @@ class QsimQuantum final : virtual public QuantumNotImpl
     void z(Qubit) final;
     //!@}
 
+    //!@{
+    //! \name Batched gates
+    // Add the gates of a recorded tape to the qsim circuit
+    void apply(GateTape const& tape);
+    // Apply a block of gates with direct calls
+    void apply(Span<GateOp const> ops) final;
+    //!@}
+
+    //!@{
+    //! \name Sampling
+    // Record one execution of a program without simulating it
+    bool record(Executor const& execute, RuntimeInterface& rt, GateTape* tape);
+
+    // Simulate gates once and sample their terminal measurements
+    ResultDistribution sample(EntryPointAttrs const& attrs,
+                              GateTape const& gates,
+                              GateTape const& outputs,
+                              SingleResultRuntime& rt,
+                              size_type num_shots);
+    //!@}
+
     //
 
   private:
     //// TYPES ////
 
-    struct Factory;
     struct State;
 
     //// DATA ////
@@ -98,14 +158,23 @@ class QsimQuantum final : virtual public QuantumNotImpl
     std::vector<bool> results_;
 
     unsigned num_threads_{};  // Number of threads to use
+    QsimKernel kernel_;
     size_t gate_index_;  // when the quantum operation will be executed
     size_type num_qubits_{};
     std::vector<Qubit> result_to_qubit_;
+    std::optional<std::uint64_t> sampled_state_;
+
+    //// CONSTANTS ////
+
+    //! Maximum number of qubits in a fused gate
+    static constexpr unsigned int max_fused_size{2};
 
     //// HELPER FUNCTIONS ////
 
     template<template<class> class Gate, class... Ts>
     void add_gate(Ts&&... args);
+    void apply_pending();
+    bool measure(Qubit q, unsigned int seed);
 };
 
 }  // namespace qiree
@@ -0,0 +1,55 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qirqsim/detail/QsimEngine.cc
+//---------------------------------------------------------------------------//
+#include "QsimEngine.hh"
+
+#include "qiree/Assert.hh"
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Create an engine for an available kernel.
+ *
+ * The automatic kernel is resolved to the fastest one supported by the CPU.
+ */
+std::unique_ptr<QsimEngine>
+make_qsim_engine(QsimKernel kernel, unsigned int num_threads)
+{
+    if (kernel == QsimKernel::automatic)
+    {
+        kernel = best_qsim_kernel();
+    }
+    QIREE_VALIDATE(is_available(kernel),
+                   << "qsim kernel '" << to_cstring(kernel)
+                   << "' is not supported by this build or CPU");
+
+    switch (kernel)
+    {
+#if QIRQSIM_HAVE_SSE
+        case QsimKernel::sse:
+            return make_qsim_engine_sse(num_threads);
+#endif
+#if QIRQSIM_HAVE_AVX2
+        case QsimKernel::avx2:
+            return make_qsim_engine_avx2(num_threads);
+#endif
+#if QIRQSIM_HAVE_AVX512
+        case QsimKernel::avx512:
+            return make_qsim_engine_avx512(num_threads);
+#endif
+        default:
+            QIREE_ASSERT(kernel == QsimKernel::basic);
+            return make_qsim_engine_basic(num_threads);
+    }
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
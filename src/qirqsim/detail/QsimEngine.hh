@@ -0,0 +1,79 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qirqsim/detail/QsimEngine.hh
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "qiree/Types.hh"
+#include "qirqsim/QsimKernel.hh"
+
+#include <qsim/lib/fuser.h>
+#include <qsim/lib/gates_qsim.h>
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * State vector and simulator for one SIMD kernel.
+ *
+ * Each vectorized implementation is built into its own shared library with
+ * the instruction set of its kernel, and only its factory function is
+ * exported. Every other symbol, including inline qsim and standard library
+ * code that is also instantiated by generic code, stays local to the library,
+ * so the linker cannot substitute a vectorized copy on a CPU without that
+ * instruction set. Implementations report failures through their return
+ * values rather than throwing, since they do not link against QIR-EE.
+ */
+class QsimEngine
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using Gate = qsim::GateQSim<float>;
+    using VecFused = std::vector<qsim::GateFused<Gate>>;
+    using VecBasis = std::vector<std::uint64_t>;
+    //!@}
+
+  public:
+    virtual ~QsimEngine() = default;
+
+    // Allocate or reuse a zeroed state, returning false if out of memory
+    virtual bool set_zero(unsigned int num_qubits) = 0;
+
+    // Apply fused gates to the state
+    virtual void apply(VecFused const& fused) = 0;
+
+    // Measure one qubit with a freshly seeded generator and collapse
+    virtual bool measure(unsigned int qubit, unsigned int seed, bool* outcome)
+        = 0;
+
+    // Sample basis states from the amplitudes without collapsing
+    virtual VecBasis sample(size_type num_samples, unsigned int seed) const
+        = 0;
+};
+
+//---------------------------------------------------------------------------//
+// Create an engine for an available kernel
+std::unique_ptr<QsimEngine>
+make_qsim_engine(QsimKernel kernel, unsigned int num_threads);
+
+//!@{
+//! Create an engine for a specific kernel (only if compiled)
+std::unique_ptr<QsimEngine> make_qsim_engine_basic(unsigned int num_threads);
+std::unique_ptr<QsimEngine> make_qsim_engine_sse(unsigned int num_threads);
+std::unique_ptr<QsimEngine> make_qsim_engine_avx2(unsigned int num_threads);
+std::unique_ptr<QsimEngine> make_qsim_engine_avx512(unsigned int num_threads);
+//!@}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
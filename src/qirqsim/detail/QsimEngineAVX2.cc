@@ -0,0 +1,28 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qirqsim/detail/QsimEngineAVX2.cc
+//---------------------------------------------------------------------------//
+#include "QsimEngineImpl.hh"
+
+#include <qsim/lib/simulator_avx.h>
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Create an engine with the AVX2 and FMA simulator.
+ */
+std::unique_ptr<QsimEngine> make_qsim_engine_avx2(unsigned int num_threads)
+{
+    using Simulator = qsim::SimulatorAVX<qsim::For>;
+    return std::make_unique<QsimEngineImpl<Simulator>>(num_threads);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,28 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qirqsim/detail/QsimEngineBasic.cc
+//---------------------------------------------------------------------------//
+#include "QsimEngineImpl.hh"
+
+#include <qsim/lib/simulator_basic.h>
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Create an engine with the scalar simulator.
+ */
+std::unique_ptr<QsimEngine> make_qsim_engine_basic(unsigned int num_threads)
+{
+    using Simulator = qsim::SimulatorBasic<qsim::For, float>;
+    return std::make_unique<QsimEngineImpl<Simulator>>(num_threads);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,137 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qirqsim/detail/QsimEngineImpl.hh
+//! \note Only include in a kernel's translation unit.
+//---------------------------------------------------------------------------//
+#pragma once
+
+#include <optional>
+#include <random>
+
+#include "QsimEngine.hh"
+
+#include <qsim/lib/formux.h>
+#include <qsim/lib/gate_appl.h>
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * State vector and simulator for a qsim simulator class.
+ */
+template<class Simulator>
+class QsimEngineImpl final : public QsimEngine
+{
+  public:
+    //!@{
+    //! \name Type aliases
+    using StateSpace = typename Simulator::StateSpace;
+    using State = typename StateSpace::State;
+    //!@}
+
+  public:
+    //! Construct with the number of threads
+    explicit QsimEngineImpl(unsigned int num_threads)
+        : state_space_{num_threads}, simulator_{num_threads}
+    {
+    }
+
+    // Allocate or reuse a zeroed state, returning false if out of memory
+    inline bool set_zero(unsigned int num_qubits) final;
+
+    // Apply fused gates to the state
+    inline void apply(VecFused const& fused) final;
+
+    // Measure one qubit with a freshly seeded generator and collapse
+    inline bool
+    measure(unsigned int qubit, unsigned int seed, bool* outcome) final;
+
+    // Sample basis states from the amplitudes without collapsing
+    inline VecBasis
+    sample(size_type num_samples, unsigned int seed) const final;
+
+  private:
+    StateSpace state_space_;
+    Simulator simulator_;
+    std::optional<State> state_;
+};
+
+//---------------------------------------------------------------------------//
+// INLINE DEFINITIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Allocate or reuse a state with the given number of qubits, zeroed.
+ *
+ * The result is false if the state could not be allocated.
+ */
+template<class S>
+bool QsimEngineImpl<S>::set_zero(unsigned int num_qubits)
+{
+    if (!state_ || state_->num_qubits() != num_qubits)
+    {
+        state_.reset();
+        state_ = state_space_.Create(num_qubits);
+        if (state_space_.IsNull(*state_))
+        {
+            state_.reset();
+            return false;
+        }
+    }
+    state_space_.SetStateZero(*state_);
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Apply fused gates to the state.
+ */
+template<class S>
+void QsimEngineImpl<S>::apply(VecFused const& fused)
+{
+    for (auto const& gate : fused)
+    {
+        qsim::ApplyFusedGate(simulator_, gate, *state_);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Measure one qubit with a freshly seeded generator and collapse the state.
+ *
+ * This matches qsim's runner, which seeds a new generator for each run. The
+ * result is false if qsim could not measure the qubit.
+ */
+template<class S>
+bool QsimEngineImpl<S>::measure(unsigned int qubit,
+                                unsigned int seed,
+                                bool* outcome)
+{
+    std::mt19937 rng(seed);
+    auto result = state_space_.Measure({qubit}, rng, *state_);
+    if (!result.valid || result.bitstring.size() != 1)
+    {
+        return false;
+    }
+    *outcome = (result.bitstring[0] != 0);
+    return true;
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Sample basis states from the amplitudes without collapsing.
+ */
+template<class S>
+auto QsimEngineImpl<S>::sample(size_type num_samples,
+                               unsigned int seed) const -> VecBasis
+{
+    return state_space_.Sample(*state_, num_samples, seed);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -0,0 +1,28 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qirqsim/detail/QsimEngineSSE.cc
+//---------------------------------------------------------------------------//
+#include "QsimEngineImpl.hh"
+
+#include <qsim/lib/simulator_sse.h>
+
+namespace qiree
+{
+namespace detail
+{
+//---------------------------------------------------------------------------//
+/*!
+ * Create an engine with the SSE4.1 simulator.
+ */
+std::unique_ptr<QsimEngine> make_qsim_engine_sse(unsigned int num_threads)
+{
+    using Simulator = qsim::SimulatorSSE<qsim::For>;
+    return std::make_unique<QsimEngineImpl<Simulator>>(num_threads);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace detail
+}  // namespace qiree
@@ -15,6 +15,9 @@
 #include <xacc/xacc_service.hpp>
 
 #include "qiree/Assert.hh"
+#include "qiree/GateTape.hh"
+#include "qiree/detail/EndGuard.hh"
+#include "qiree/detail/GateDispatch.hh"
 
 using xacc::constants::pi;
 
@@ -307,8 +310,70 @@ void XaccQuantum::print_accelbuf()
     buffer_->print(output_);
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * Add the gates of a recorded tape to the XACC circuit.
+ *
+ * The circuit is executed lazily as usual. Runtime output operations in the
+ * tape are ignored.
+ */
+void XaccQuantum::apply(GateTape const& tape)
+{
+    this->add_block(tape);
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Add a block of gates to the XACC circuit.
+ */
+void XaccQuantum::apply(Span<GateOp const> ops)
+{
+    this->add_block(ops);
+}
+
 //---------------------------------------------------------------------------//
 // PRIVATE FUNCTIONS
+//---------------------------------------------------------------------------//
+/*!
+ * Add the gates of a block to the circuit in a single call.
+ *
+ * Gates are converted to XACC instructions with direct calls to this class
+ * rather than through the quantum interface, and the instructions are added
+ * to the circuit together with one \c addInstructions call.
+ */
+template<class T>
+void XaccQuantum::add_block(T const& ops)
+{
+    QIREE_EXPECT(!in_block_);
+    in_block_ = true;
+    detail::EndGuard on_end_scope_([this] {
+        in_block_ = false;
+        block_.clear();
+    });
+
+    detail::dispatch_gates(ops, *this);
+    if (!block_.empty())
+    {
+        cur_circuit_->addInstructions(block_);
+    }
+}
+
+//---------------------------------------------------------------------------//
+/*!
+ * Add an instruction to the circuit or the current block.
+ */
+void XaccQuantum::append(std::shared_ptr<xacc::Instruction> instr)
+{
+    if (in_block_)
+    {
+        block_.push_back(std::move(instr));
+    }
+    else
+    {
+        cur_circuit_->addInstruction(std::move(instr));
+    }
+}
+
 //---------------------------------------------------------------------------//
 /*!
  * Add an instruction with a single qubit.
@@ -356,8 +421,15 @@ void XaccQuantum::add_instruction_to(
     auto instr = provider_->createInstruction(
         std::move(s), q_indices, VecInstr{std::forward<Ts>(args)...});
 
-    // Add to current quantum circuit
-    circuit->addInstruction(std::move(instr));
+    // Add to the quantum circuit
+    if (circuit == cur_circuit_)
+    {
+        this->append(std::move(instr));
+    }
+    else
+    {
+        circuit->addInstruction(std::move(instr));
+    }
 }
 
 //---------------------------------------------------------------------------//
@@ -381,7 +453,7 @@ void XaccQuantum::add_ctrl_indices_instruction(std::string s,
 
     for (int i = 0; i < cu->nInstructions(); i++)
     {
-        cur_circuit_->addInstruction(cu->getInstruction(i));
+        this->append(cu->getInstruction(i));
     }
 }
 
@@ -24,10 +24,13 @@ class AcceleratorBuffer;
 class Accelerator;
 class IRProvider;
 class CompositeInstruction;
+class Instruction;
 }  // namespace xacc
 
 namespace qiree
 {
+//---------------------------------------------------------------------------//
+class GateTape;
 
 //---------------------------------------------------------------------------//
 /*!
@@ -97,6 +100,14 @@ class XaccQuantum final : virtual public QuantumNotImpl
     void z(Qubit) final;
     //!@}
 
+    //!@{
+    //! \name Batched gates
+    // Add the gates of a recorded tape to the XACC circuit
+    void apply(GateTape const& tape);
+    // Apply a block of gates with direct calls
+    void apply(Span<GateOp const> ops) final;
+    //!@}
+
     //!@{
     //! \name Utilities for runtime
     // Get runtime qubit corresponding to a runtime result
@@ -134,9 +145,18 @@ class XaccQuantum final : virtual public QuantumNotImpl
     std::shared_ptr<xacc::Accelerator> accelerator_;
     std::shared_ptr<xacc::IRProvider> provider_;
     std::shared_ptr<xacc::CompositeInstruction> cur_circuit_;
+    std::vector<std::shared_ptr<xacc::Instruction>> block_;
+    bool in_block_{false};
 
     //// HELPER FUNCTIONS ////
 
+    // Add the gates of a block to the circuit in a single call
+    template<class T>
+    void add_block(T const& ops);
+
+    // Add an instruction to the circuit or the current block
+    void append(std::shared_ptr<xacc::Instruction> instr);
+
     // Add an instruction with a single qubit
     template<class... Ts>
     void add_instruction(std::string s, Qubit q, Ts... args);
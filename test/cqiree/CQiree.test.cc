@@ -30,6 +30,9 @@ DECLARE_FUNCPTR(load_module_from_memory);
 DECLARE_FUNCPTR(load_module_from_file);
 DECLARE_FUNCPTR(num_quantum_reg);
 DECLARE_FUNCPTR(num_classical_reg);
+DECLARE_FUNCPTR(set_num_threads);
+DECLARE_FUNCPTR(set_cache_dir);
+DECLARE_FUNCPTR(set_opt_level);
 DECLARE_FUNCPTR(max_result_items);
 DECLARE_FUNCPTR(setup_executor);
 DECLARE_FUNCPTR(execute);
@@ -57,6 +60,9 @@ class CQireeTest : public ::qiree::test::Test
         LOAD_FUNCPTR(load_module_from_file);
         LOAD_FUNCPTR(num_quantum_reg);
         LOAD_FUNCPTR(num_classical_reg);
+        LOAD_FUNCPTR(set_num_threads);
+        LOAD_FUNCPTR(set_cache_dir);
+        LOAD_FUNCPTR(set_opt_level);
         LOAD_FUNCPTR(max_result_items);
         LOAD_FUNCPTR(setup_executor);
         LOAD_FUNCPTR(execute);
@@ -84,6 +90,9 @@ class CQireeTest : public ::qiree::test::Test
     qiree_load_module_from_file_t load_module_from_file_fn_ = nullptr;
     qiree_num_quantum_reg_t num_quantum_reg_fn_ = nullptr;
     qiree_num_classical_reg_t num_classical_reg_fn_ = nullptr;
+    qiree_set_num_threads_t set_num_threads_fn_ = nullptr;
+    qiree_set_cache_dir_t set_cache_dir_fn_ = nullptr;
+    qiree_set_opt_level_t set_opt_level_fn_ = nullptr;
     qiree_max_result_items_t max_result_items_fn_ = nullptr;
     qiree_setup_executor_t setup_executor_fn_ = nullptr;
     qiree_execute_t execute_fn_ = nullptr;
@@ -187,6 +196,50 @@ TEST_F(CQireeTest, QueryRegisters)
     destroy_fn_(manager);
 }
 
+TEST_F(CQireeTest, SetNumThreads)
+{
+    CQiree* manager = create_fn_();
+    ASSERT_NE(manager, nullptr);
+
+    EXPECT_EQ(QIREE_SUCCESS, set_num_threads_fn_(manager, 2));
+    EXPECT_EQ(QIREE_SUCCESS, set_num_threads_fn_(manager, 0));
+
+    // Test invalid inputs
+    EXPECT_EQ(QIREE_NOT_READY, set_num_threads_fn_(nullptr, 2));
+    EXPECT_EQ(QIREE_INVALID_INPUT, set_num_threads_fn_(manager, -1));
+
+    destroy_fn_(manager);
+}
+
+TEST_F(CQireeTest, SetCacheDir)
+{
+    CQiree* manager = create_fn_();
+    ASSERT_NE(manager, nullptr);
+
+    EXPECT_EQ(QIREE_SUCCESS, set_cache_dir_fn_(manager, "cqiree-cache"));
+    EXPECT_EQ(QIREE_SUCCESS, set_cache_dir_fn_(manager, nullptr));
+
+    // Test invalid inputs
+    EXPECT_EQ(QIREE_NOT_READY, set_cache_dir_fn_(nullptr, "cqiree-cache"));
+
+    destroy_fn_(manager);
+}
+
+TEST_F(CQireeTest, SetOptLevel)
+{
+    CQiree* manager = create_fn_();
+    ASSERT_NE(manager, nullptr);
+
+    EXPECT_EQ(QIREE_SUCCESS, set_opt_level_fn_(manager, 2));
+
+    // Test invalid inputs
+    EXPECT_EQ(QIREE_NOT_READY, set_opt_level_fn_(nullptr, 2));
+    EXPECT_EQ(QIREE_INVALID_INPUT, set_opt_level_fn_(manager, -1));
+    EXPECT_EQ(QIREE_INVALID_INPUT, set_opt_level_fn_(manager, 4));
+
+    destroy_fn_(manager);
+}
+
 TEST_F(CQireeTest, Run)
 {
     CQiree* manager = create_fn_();
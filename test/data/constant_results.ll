@@ -0,0 +1,49 @@
+; ModuleID = 'ConstantResults'
+source_filename = "ConstantResults"
+
+%Qubit = type opaque
+%Result = type opaque
+
+define void @main() #0 {
+entry:
+  %one = call %Result* @__quantum__rt__result_get_one()
+  %zero = call %Result* @__quantum__rt__result_get_zero()
+  %is_one = call i1 @__quantum__qis__read_result__body(%Result* %one)
+  br i1 %is_one, label %then, label %continue
+
+then:
+  call void @__quantum__qis__h__body(%Qubit* null)
+  br label %continue
+
+continue:
+  call void @__quantum__qis__mz__body(%Qubit* null, %Result* null)
+  call void @__quantum__rt__array_record_output(i64 3, i8* null)
+  call void @__quantum__rt__result_record_output(%Result* null, i8* null)
+  call void @__quantum__rt__result_record_output(%Result* %one, i8* null)
+  call void @__quantum__rt__result_record_output(%Result* %zero, i8* null)
+  ret void
+}
+
+declare %Result* @__quantum__rt__result_get_one()
+
+declare %Result* @__quantum__rt__result_get_zero()
+
+declare i1 @__quantum__qis__read_result__body(%Result*)
+
+declare void @__quantum__qis__h__body(%Qubit*)
+
+declare void @__quantum__qis__mz__body(%Qubit*, %Result* writeonly) #1
+
+declare void @__quantum__rt__array_record_output(i64, i8*)
+
+declare void @__quantum__rt__result_record_output(%Result*, i8*)
+
+attributes #0 = { "entry_point" "num_required_qubits"="1" "num_required_results"="1" "output_labeling_schema" "qir_profiles"="adaptive_profile" }
+attributes #1 = { "irreversible" }
+
+!llvm.module.flags = !{!0, !1, !2, !3}
+
+!0 = !{i32 1, !"qir_major_version", i32 1}
+!1 = !{i32 7, !"qir_minor_version", i32 0}
+!2 = !{i32 1, !"dynamic_qubit_management", i1 false}
+!3 = !{i32 1, !"dynamic_result_management", i1 false}
@@ -0,0 +1,55 @@
+; ModuleID = 'lazy'
+source_filename = "lazy"
+
+; Source for lazy.bc: only @main and @bell are reachable from the entry point.
+; The body of @unused calls a function that QIR-EE does not implement.
+
+%Qubit = type opaque
+%Result = type opaque
+%String = type opaque
+
+define void @main() #0 {
+entry:
+  call void @bell(%Qubit* null, %Qubit* inttoptr (i64 1 to %Qubit*))
+  call void @__quantum__qis__mz__body(%Qubit* null, %Result* null)
+  call void @__quantum__qis__mz__body(%Qubit* inttoptr (i64 1 to %Qubit*), %Result* inttoptr (i64 1 to %Result*))
+  call void @__quantum__rt__array_record_output(i64 2, i8* null)
+  call void @__quantum__rt__result_record_output(%Result* null, i8* null)
+  call void @__quantum__rt__result_record_output(%Result* inttoptr (i64 1 to %Result*), i8* null)
+  ret void
+}
+
+define internal void @bell(%Qubit* %q1, %Qubit* %q2) {
+entry:
+  call void @__quantum__qis__h__body(%Qubit* %q1)
+  call void @__quantum__qis__cnot__body(%Qubit* %q1, %Qubit* %q2)
+  ret void
+}
+
+define void @unused(%String* %s) {
+entry:
+  call void @__quantum__rt__message(%String* %s)
+  ret void
+}
+
+declare void @__quantum__qis__h__body(%Qubit*)
+
+declare void @__quantum__qis__cnot__body(%Qubit*, %Qubit*)
+
+declare void @__quantum__qis__mz__body(%Qubit*, %Result* writeonly) #1
+
+declare void @__quantum__rt__array_record_output(i64, i8*)
+
+declare void @__quantum__rt__result_record_output(%Result*, i8*)
+
+declare void @__quantum__rt__message(%String*)
+
+attributes #0 = { "entry_point" "num_required_qubits"="2" "num_required_results"="2" "output_labeling_schema" "qir_profiles"="custom" }
+attributes #1 = { "irreversible" }
+
+!llvm.module.flags = !{!0, !1, !2, !3}
+
+!0 = !{i32 1, !"qir_major_version", i32 1}
+!1 = !{i32 7, !"qir_minor_version", i32 0}
+!2 = !{i32 1, !"dynamic_qubit_management", i1 false}
+!3 = !{i32 1, !"dynamic_result_management", i1 false}
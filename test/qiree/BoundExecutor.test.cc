@@ -0,0 +1,104 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/BoundExecutor.test.cc
+//---------------------------------------------------------------------------//
+#include "qiree/BoundExecutor.hh"
+
+#include <cstdint>
+
+#include "QuantumTestImpl.hh"
+#include "qiree/Module.hh"
+#include "qiree_test.hh"
+
+namespace qiree
+{
+namespace test
+{
+//---------------------------------------------------------------------------//
+int num_h_calls{0};
+
+void count_h(std::uintptr_t)
+{
+    ++num_h_calls;
+}
+
+//---------------------------------------------------------------------------//
+class BoundExecutorTest : public ::qiree::test::Test
+{
+  protected:
+    Module load(std::string const& filename)
+    {
+        return Module(this->test_data_path(filename));
+    }
+};
+
+//---------------------------------------------------------------------------//
+TEST_F(BoundExecutorTest, matches_virtual)
+{
+    using BoundTestExecutor = BoundExecutor<QuantumTestImpl, ResultTestImpl>;
+
+    for (char const* filename : {"bell.ll",
+                                 "constant_results.ll",
+                                 "loop.ll",
+                                 "pyqir_several_gates.ll",
+                                 "rotation.ll",
+                                 "teleport.ll"})
+    {
+        SCOPED_TRACE(filename);
+        TestResult expected;
+        {
+            Executor execute{this->load(filename)};
+            QuantumTestImpl quantum_impl(&expected);
+            ResultTestImpl result_impl(&expected);
+            execute(quantum_impl, result_impl);
+        }
+
+        for (auto engine : {JitEngine::mcjit, JitEngine::orc_lazy})
+        {
+            SCOPED_TRACE(to_cstring(engine));
+            ExecutorOptions options;
+            options.engine = engine;
+            BoundTestExecutor execute{this->load(filename), options};
+
+            TestResult actual;
+            QuantumTestImpl quantum_impl(&actual);
+            ResultTestImpl result_impl(&actual);
+            execute(quantum_impl, result_impl);
+            EXPECT_EQ(expected.commands.str(), actual.commands.str());
+
+            TestResult looped;
+            QuantumTestImpl loop_quantum_impl(&looped);
+            ResultTestImpl loop_result_impl(&looped);
+            execute.run_shots(loop_quantum_impl, loop_result_impl, 1, {});
+            EXPECT_EQ(expected.commands.str(), looped.commands.str());
+        }
+    }
+}
+
+TEST_F(BoundExecutorTest, overrides)
+{
+    FunctionOverrides overrides;
+    overrides["__quantum__qis__h__body"]
+        = reinterpret_cast<void (*)()>(&count_h);
+    Executor execute{this->load("bell.ll"), {}, overrides};
+
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    ResultTestImpl result_impl(&tr);
+    num_h_calls = 0;
+    execute(quantum_impl, result_impl);
+    EXPECT_EQ(1, num_h_calls);
+    EXPECT_EQ(std::string::npos, tr.commands.str().find("h("));
+    EXPECT_NE(std::string::npos, tr.commands.str().find("cnot("));
+
+    overrides = {{"__quantum__qis__fredkin__body",
+                  reinterpret_cast<void (*)()>(&count_h)}};
+    EXPECT_THROW(Executor(this->load("bell.ll"), {}, overrides), RuntimeError);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace test
+}  // namespace qiree
@@ -0,0 +1,139 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/CircuitAnalysis.test.cc
+//---------------------------------------------------------------------------//
+#include "qiree/CircuitAnalysis.hh"
+
+#include "qiree/Module.hh"
+#include "qiree_test.hh"
+
+namespace qiree
+{
+namespace test
+{
+//---------------------------------------------------------------------------//
+
+class CircuitAnalysisTest : public ::qiree::test::Test
+{
+  protected:
+    using MapStrCount = CircuitAnalysis::MapStrCount;
+    using MapPairCount = CircuitAnalysis::MapPairCount;
+
+    CircuitAnalysis analyze(std::string const& filename)
+    {
+        return CircuitAnalysis{Module(this->test_data_path(filename))};
+    }
+};
+
+//---------------------------------------------------------------------------//
+TEST_F(CircuitAnalysisTest, bell)
+{
+    for (char const* filename : {"bell.ll", "bell.bc", "lazy.bc"})
+    {
+        SCOPED_TRACE(filename);
+        auto a = this->analyze(filename);
+        EXPECT_EQ((MapStrCount{{"cnot", 1}, {"h", 1}, {"mz", 2}}),
+                  a.gate_counts());
+        EXPECT_EQ(4, a.num_gates());
+        EXPECT_EQ(1, a.num_two_qubit_gates());
+        EXPECT_EQ(3, a.depth());
+        EXPECT_EQ(2, a.num_qubits());
+        EXPECT_EQ((MapPairCount{{{0, 1}, 1}}), a.interactions());
+        EXPECT_FALSE(a.measurement_feedback());
+        EXPECT_TRUE(a.complete());
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(CircuitAnalysisTest, loop)
+{
+    auto a = this->analyze("loop.ll");
+    EXPECT_EQ((MapStrCount{{"h", 5}, {"mz", 1}}), a.gate_counts());
+    EXPECT_EQ(0, a.num_two_qubit_gates());
+    EXPECT_EQ(6, a.depth());
+    EXPECT_EQ(1, a.num_qubits());
+    EXPECT_TRUE(a.interactions().empty());
+    EXPECT_TRUE(a.complete());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(CircuitAnalysisTest, multiple)
+{
+    // Calls into internal functions are followed
+    auto a = this->analyze("multiple.ll");
+    EXPECT_EQ((MapStrCount{{"cnot", 2}, {"h", 4}, {"mz", 1}}),
+              a.gate_counts());
+    EXPECT_EQ((MapPairCount{{{0, 1}, 2}}), a.interactions());
+    EXPECT_EQ(5, a.depth());
+    EXPECT_TRUE(a.complete());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(CircuitAnalysisTest, teleport)
+{
+    // Analysis stops at the first branch on a measurement
+    auto a = this->analyze("teleport.ll");
+    EXPECT_TRUE(a.measurement_feedback());
+    EXPECT_FALSE(a.complete());
+    EXPECT_EQ((MapStrCount{{"cnot", 2}, {"h", 2}, {"mz", 1}, {"reset", 1}}),
+              a.gate_counts());
+    EXPECT_EQ(3, a.num_qubits());
+    EXPECT_EQ((MapPairCount{{{0, 1}, 1}, {{1, 2}, 1}}), a.interactions());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(CircuitAnalysisTest, stack_loop)
+{
+    // Unoptimized loop with a stack variable and a computed qubit index
+    auto m = Module::from_bytes(R"(
+%Qubit = type opaque
+
+define void @main() #0 {
+entry:
+  %i = alloca i64
+  store i64 0, i64* %i
+  br label %cond
+cond:
+  %0 = load i64, i64* %i
+  %1 = icmp ult i64 %0, 3
+  br i1 %1, label %body, label %exit
+body:
+  %q = call i64 @next(i64 %0)
+  %p = inttoptr i64 %q to %Qubit*
+  call void @__quantum__qis__rx__body(double 0.5, %Qubit* %p)
+  call void @__quantum__qis__cz__body(%Qubit* null, %Qubit* %p)
+  %2 = add i64 %0, 1
+  store i64 %2, i64* %i
+  br label %cond
+exit:
+  ret void
+}
+
+define internal i64 @next(i64 %x) {
+  %y = add i64 %x, 1
+  ret i64 %y
+}
+
+declare void @__quantum__qis__rx__body(double, %Qubit*)
+declare void @__quantum__qis__cz__body(%Qubit*, %Qubit*)
+
+attributes #0 = { "entry_point" }
+)");
+
+    CircuitAnalysis a{*m};
+    EXPECT_EQ((MapStrCount{{"cz", 3}, {"rx", 3}}), a.gate_counts());
+    EXPECT_EQ(3, a.num_two_qubit_gates());
+    EXPECT_EQ(4, a.depth());
+    EXPECT_EQ(4, a.num_qubits());
+    EXPECT_EQ((MapPairCount{{{0, 1}, 1}, {{0, 2}, 1}, {{0, 3}, 1}}),
+              a.interactions());
+    EXPECT_FALSE(a.measurement_feedback());
+    EXPECT_TRUE(a.complete());
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace test
+}  // namespace qiree
@@ -7,6 +7,11 @@
 //---------------------------------------------------------------------------//
 #include "qiree/Executor.hh"
 
+#include <cstdint>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
 #include "QuantumTestImpl.hh"
 #include "qiree/Assert.hh"
 #include "qiree/Module.hh"
@@ -16,6 +21,14 @@ namespace qiree
 {
 namespace test
 {
+//---------------------------------------------------------------------------//
+QuantumInterface* mz_target{nullptr};
+
+void override_mz(std::uintptr_t q, std::uintptr_t r)
+{
+    mz_target->mz(Qubit{q}, Result{r});
+}
+
 //---------------------------------------------------------------------------//
 
 class ExecutorTest : public ::qiree::test::Test
@@ -26,6 +39,8 @@ class ExecutorTest : public ::qiree::test::Test
     TestResult run(std::string const& filename);
     TestResult run(std::string const& filename, std::string const& entry);
 
+    ExecutorOptions options;
+
   private:
     TestResult run_impl(Module&& m);
 };
@@ -47,7 +62,7 @@ ExecutorTest::run(std::string const& filename, std::string const& entry)
 TestResult ExecutorTest::run_impl(Module&& m)
 {
     QIREE_EXPECT(m);
-    Executor execute(std::move(m));
+    Executor execute(std::move(m), options);
 
     // Run with the test interface
     TestResult tr;
@@ -259,6 +274,794 @@ tear_down
     // cout << result.commands.str();
 }
 
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, multithreaded)
+{
+    Executor execute(Module(this->test_data_path("bell.ll")));
+
+    // Run the same executor simultaneously on independent interfaces
+    constexpr int num_threads = 4;
+    std::vector<TestResult> results(num_threads);
+    std::vector<std::thread> threads;
+    for (auto& tr : results)
+    {
+        threads.emplace_back([&execute, &tr] {
+            QuantumTestImpl quantum_impl(&tr);
+            ResultTestImpl result_impl(&tr);
+            for (int shot = 0; shot < 10; ++shot)
+            {
+                execute(quantum_impl, result_impl);
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    std::string const expected_shot = R"(set_up(q=2, r=2)
+h(Q{0})
+cnot(Q{0}, Q{1})
+mz(Q{0},R{0})
+mz(Q{1},R{1})
+array_record_output(2)
+result_record_output(R{0})
+result_record_output(R{1})
+tear_down
+)";
+    std::string expected = "\n";
+    for (int shot = 0; shot < 10; ++shot)
+    {
+        expected += expected_shot;
+    }
+    for (auto const& tr : results)
+    {
+        EXPECT_EQ(expected, tr.commands.str());
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, run_shots)
+{
+    for (auto engine : {JitEngine::mcjit, JitEngine::orc, JitEngine::orc_lazy})
+    {
+        SCOPED_TRACE(to_cstring(engine));
+        options.engine = engine;
+        Executor execute(Module(this->test_data_path("teleport.ll")), options);
+
+        TestResult expected;
+        {
+            QuantumTestImpl quantum_impl(&expected);
+            ResultTestImpl result_impl(&expected);
+            for (int shot = 0; shot < 3; ++shot)
+            {
+                execute(quantum_impl, result_impl);
+            }
+        }
+
+        TestResult actual;
+        QuantumTestImpl quantum_impl(&actual);
+        ResultTestImpl result_impl(&actual);
+        std::vector<size_type> shots;
+        execute.run_shots(quantum_impl,
+                          result_impl,
+                          3,
+                          [&shots, &actual](size_type shot) {
+                              // Called after tear_down
+                              EXPECT_EQ("tear_down\n",
+                                        actual.commands.str().substr(
+                                            actual.commands.str().size() - 10));
+                              shots.push_back(shot);
+                          });
+        EXPECT_EQ(expected.commands.str(), actual.commands.str());
+        EXPECT_EQ((std::vector<size_type>{0, 1, 2}), shots);
+
+        // No shots and no callback
+        execute.run_shots(quantum_impl, result_impl, 0, {});
+        EXPECT_EQ(expected.commands.str(), actual.commands.str());
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, engines)
+{
+    EXPECT_EQ(JitEngine::orc_lazy, to_jit_engine("orc-lazy"));
+    EXPECT_THROW(to_jit_engine("interpreter"), RuntimeError);
+
+    for (char const* filename : {"bell.ll", "loop.ll", "teleport.ll"})
+    {
+        SCOPED_TRACE(filename);
+        options.engine = JitEngine::mcjit;
+        auto const expected = this->run(filename).commands.str();
+        for (auto engine : {JitEngine::orc, JitEngine::orc_lazy})
+        {
+            SCOPED_TRACE(to_cstring(engine));
+            options.engine = engine;
+            EXPECT_EQ(expected, this->run(filename).commands.str());
+        }
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, opt_levels)
+{
+    EXPECT_STREQ("O2", to_cstring(OptLevel::O2));
+
+    for (char const* filename : {"bell.ll", "loop.ll", "teleport.ll"})
+    {
+        SCOPED_TRACE(filename);
+        auto const expected = this->run(filename).commands.str();
+        for (auto level : {OptLevel::O1, OptLevel::O2, OptLevel::O3})
+        {
+            SCOPED_TRACE(to_cstring(level));
+            options.opt_level = level;
+            EXPECT_EQ(expected, this->run(filename).commands.str());
+        }
+        options.opt_level = OptLevel::O0;
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, opt_stats)
+{
+    auto get_stats = [this](OptLevel level) {
+        options.opt_level = level;
+        Executor execute(Module(this->test_data_path("loop.ll")), options);
+        return execute.stats().optimization;
+    };
+
+    auto unopt = get_stats(OptLevel::O0);
+    EXPECT_EQ(11, unopt.instructions_before);
+    EXPECT_EQ(unopt.instructions_before, unopt.instructions_after);
+    EXPECT_EQ(4, unopt.calls_before);
+    EXPECT_EQ(0, unopt.calls_removed());
+
+    // The loop is fully unrolled: the branches and induction variable vanish,
+    // leaving five straight-line H calls
+    auto opt = get_stats(OptLevel::O2);
+    EXPECT_EQ(11, opt.instructions_before);
+    EXPECT_EQ(9, opt.instructions_after);
+    EXPECT_EQ(4, opt.calls_before);
+    EXPECT_EQ(8, opt.calls_after);
+    EXPECT_EQ(2, opt.instructions_removed());
+    EXPECT_EQ(-4, opt.calls_removed());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, linked_library)
+{
+    auto m = Module::from_bytes(R"(
+%Qubit = type opaque
+%Result = type opaque
+
+define void @main() #0 {
+  call void @entangle(%Qubit* null, %Qubit* inttoptr (i64 1 to %Qubit*))
+  call void @entangle(%Qubit* null, %Qubit* inttoptr (i64 1 to %Qubit*))
+  call void @__quantum__qis__mz__body(%Qubit* null, %Result* null)
+  call void @__quantum__rt__result_record_output(%Result* null, i8* null)
+  ret void
+}
+
+declare void @entangle(%Qubit*, %Qubit*)
+declare void @__quantum__qis__mz__body(%Qubit*, %Result*)
+declare void @__quantum__rt__result_record_output(%Result*, i8*)
+
+attributes #0 = { "entry_point" "required_num_qubits"="2" "required_num_results"="1" }
+)");
+    m->link_bytes(R"(
+%Qubit = type opaque
+
+define void @entangle(%Qubit* %a, %Qubit* %b) {
+  call void @__quantum__qis__cnot__body(%Qubit* %a, %Qubit* %b)
+  ret void
+}
+
+define void @unused(%Qubit* %a) {
+  call void @__quantum__qis__h__body(%Qubit* %a)
+  ret void
+}
+
+declare void @__quantum__qis__cnot__body(%Qubit*, %Qubit*)
+declare void @__quantum__qis__h__body(%Qubit*)
+)");
+    EXPECT_EQ(1, m->num_linked());
+
+    // Library calls are inlined so the two CNOTs become adjacent and cancel
+    options.simplify_gates = true;
+    Executor execute(std::move(*m), options);
+    auto const stats = execute.stats().optimization;
+    EXPECT_EQ(4, stats.calls_before);
+    EXPECT_EQ(2, stats.gates_removed);
+
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    ResultTestImpl result_impl(&tr);
+    execute(quantum_impl, result_impl);
+    EXPECT_EQ(R"(
+set_up(q=2, r=1)
+mz(Q{0},R{0})
+result_record_output(R{0})
+tear_down
+)",
+              tr.commands.str());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, simplify_gates)
+{
+    std::string const ir = R"(
+%Qubit = type opaque
+%Result = type opaque
+
+define void @main() #0 {
+  ; Self-inverse pairs cancel
+  call void @__quantum__qis__h__body(%Qubit* null)
+  call void @__quantum__qis__h__body(%Qubit* null)
+  call void @__quantum__qis__cnot__body(%Qubit* null, %Qubit* inttoptr (i64 1 to %Qubit*))
+  call void @__quantum__qis__cnot__body(%Qubit* null, %Qubit* inttoptr (i64 1 to %Qubit*))
+  ; S^2 = Z, which then cancels
+  call void @__quantum__qis__s__body(%Qubit* inttoptr (i64 1 to %Qubit*))
+  call void @__quantum__qis__s__body(%Qubit* inttoptr (i64 1 to %Qubit*))
+  call void @__quantum__qis__z__body(%Qubit* inttoptr (i64 1 to %Qubit*))
+  ; Rotations merge
+  call void @__quantum__qis__rz__body(double 2.5e-1, %Qubit* inttoptr (i64 2 to %Qubit*))
+  call void @__quantum__qis__rz__body(double 5.0e-1, %Qubit* inttoptr (i64 2 to %Qubit*))
+  ; Gates on other qubits don't interfere, but measurements do
+  call void @__quantum__qis__h__body(%Qubit* null)
+  call void @__quantum__qis__x__body(%Qubit* inttoptr (i64 2 to %Qubit*))
+  call void @__quantum__qis__h__body(%Qubit* null)
+  call void @__quantum__qis__mz__body(%Qubit* inttoptr (i64 2 to %Qubit*), %Result* null)
+  call void @__quantum__qis__x__body(%Qubit* inttoptr (i64 2 to %Qubit*))
+  ; Reversed operands don't cancel
+  call void @__quantum__qis__cnot__body(%Qubit* null, %Qubit* inttoptr (i64 1 to %Qubit*))
+  call void @__quantum__qis__cnot__body(%Qubit* inttoptr (i64 1 to %Qubit*), %Qubit* null)
+  ret void
+}
+
+declare void @__quantum__qis__h__body(%Qubit*)
+declare void @__quantum__qis__x__body(%Qubit*)
+declare void @__quantum__qis__z__body(%Qubit*)
+declare void @__quantum__qis__s__body(%Qubit*)
+declare void @__quantum__qis__cnot__body(%Qubit*, %Qubit*)
+declare void @__quantum__qis__rz__body(double, %Qubit*)
+declare void @__quantum__qis__mz__body(%Qubit*, %Result*)
+
+attributes #0 = { "entry_point" "num_required_qubits"="3" }
+)";
+
+    auto run = [this, &ir](ExecutorStats* stats) {
+        Executor execute(std::move(*Module::from_bytes(ir)), options);
+        *stats = execute.stats();
+        TestResult tr;
+        QuantumTestImpl quantum_impl(&tr);
+        ResultTestImpl result_impl(&tr);
+        execute(quantum_impl, result_impl);
+        return tr.commands.str();
+    };
+
+    ExecutorStats stats;
+    auto unsimplified = run(&stats);
+    EXPECT_EQ(0, stats.optimization.gates_removed);
+
+    options.simplify_gates = true;
+    EXPECT_EQ(R"(
+set_up(q=3, r=0)
+rz(0.75, Q{2})
+TODO: x.body
+mz(Q{2},R{0})
+TODO: x.body
+cnot(Q{0}, Q{1})
+cnot(Q{1}, Q{0})
+tear_down
+)",
+              run(&stats))
+        << unsimplified;
+    EXPECT_EQ(10, stats.optimization.gates_removed);
+    EXPECT_EQ(stats.optimization.calls_before - 10,
+              stats.optimization.calls_after);
+
+    // Unrolled loop of five H gates leaves one
+    options.opt_level = OptLevel::O2;
+    Executor execute(Module(this->test_data_path("loop.ll")), options);
+    EXPECT_EQ(4, execute.stats().optimization.gates_removed);
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, prune_lightcone)
+{
+    std::string const ir = R"(
+%Qubit = type opaque
+%Result = type opaque
+
+define void @main() #0 {
+  call void @__quantum__qis__h__body(%Qubit* null)
+  call void @__quantum__qis__x__body(%Qubit* inttoptr (i64 1 to %Qubit*))
+  call void @__quantum__qis__h__body(%Qubit* inttoptr (i64 2 to %Qubit*))
+  call void @__quantum__qis__cnot__body(%Qubit* inttoptr (i64 2 to %Qubit*), %Qubit* null)
+  call void @__quantum__qis__cnot__body(%Qubit* inttoptr (i64 1 to %Qubit*), %Qubit* inttoptr (i64 2 to %Qubit*))
+  call void @__quantum__qis__mz__body(%Qubit* inttoptr (i64 1 to %Qubit*), %Result* inttoptr (i64 1 to %Result*))
+  call void @__quantum__qis__mz__body(%Qubit* null, %Result* null)
+  call void @__quantum__rt__result_record_output(%Result* null, i8* null)
+  ret void
+}
+
+declare void @__quantum__qis__h__body(%Qubit*)
+declare void @__quantum__qis__x__body(%Qubit*)
+declare void @__quantum__qis__cnot__body(%Qubit*, %Qubit*)
+declare void @__quantum__qis__mz__body(%Qubit*, %Result*)
+declare void @__quantum__rt__result_record_output(%Result*, i8*)
+
+attributes #0 = { "entry_point" "required_num_qubits"="3" "required_num_results"="2" }
+)";
+
+    // Only qubit 0 is recorded, and qubit 2 interacts with it before qubit 1
+    options.prune_lightcone = true;
+    Executor execute(std::move(*Module::from_bytes(ir)), options);
+    EXPECT_EQ(3, execute.stats().optimization.gates_pruned);
+
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    ResultTestImpl result_impl(&tr);
+    execute(quantum_impl, result_impl);
+    EXPECT_EQ(R"(
+set_up(q=3, r=2)
+h(Q{0})
+h(Q{2})
+cnot(Q{2}, Q{0})
+mz(Q{0},R{0})
+result_record_output(R{0})
+tear_down
+)",
+              tr.commands.str());
+
+    // Every result is recorded
+    Executor bell(Module(this->test_data_path("bell.ll")), options);
+    EXPECT_EQ(0, bell.stats().optimization.gates_pruned);
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, buffer_gates)
+{
+    for (char const* filename :
+         {"bell.ll", "loop.ll", "rotation.ll", "teleport.ll"})
+    {
+        SCOPED_TRACE(filename);
+        auto const expected = this->run(filename).commands.str();
+        options.buffer_gates = true;
+        for (auto engine : {JitEngine::mcjit, JitEngine::orc_lazy})
+        {
+            for (auto level : {OptLevel::O0, OptLevel::O2})
+            {
+                SCOPED_TRACE(to_cstring(engine));
+                SCOPED_TRACE(to_cstring(level));
+                options.engine = engine;
+                options.opt_level = level;
+                EXPECT_EQ(expected, this->run(filename).commands.str());
+            }
+        }
+        options = {};
+    }
+
+    // Gates are flushed before measurements and at the end of each shot
+    options.buffer_gates = true;
+    Executor execute(Module(this->test_data_path("teleport.ll")), options);
+    EXPECT_LT(0, execute.stats().optimization.gates_buffered);
+    TestResult expected;
+    {
+        QuantumTestImpl quantum_impl(&expected);
+        ResultTestImpl result_impl(&expected);
+        execute(quantum_impl, result_impl);
+        execute(quantum_impl, result_impl);
+    }
+    TestResult actual;
+    QuantumTestImpl quantum_impl(&actual);
+    ResultTestImpl result_impl(&actual);
+    execute.run_shots(quantum_impl, result_impl, 2, {});
+    EXPECT_EQ(expected.commands.str(), actual.commands.str());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, buffer_gates_overrides)
+{
+    // Overrides bypass the interfaces, so buffered gates are sent first
+    auto const expected = this->run("bell.ll").commands.str();
+    FunctionOverrides const overrides{
+        {"__quantum__qis__mz__body",
+         reinterpret_cast<void (*)()>(&override_mz)}};
+    options.buffer_gates = true;
+    for (auto level : {OptLevel::O0, OptLevel::O2})
+    {
+        SCOPED_TRACE(to_cstring(level));
+        options.opt_level = level;
+        Executor execute(
+            Module(this->test_data_path("bell.ll")), options, overrides);
+        EXPECT_LT(0, execute.stats().optimization.gates_buffered);
+
+        TestResult tr;
+        QuantumTestImpl quantum_impl(&tr);
+        ResultTestImpl result_impl(&tr);
+        mz_target = &quantum_impl;
+        execute(quantum_impl, result_impl);
+        EXPECT_EQ(expected, tr.commands.str());
+    }
+    mz_target = nullptr;
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, buffer_gates_overflow)
+{
+    // More gates than fit in the buffer
+    auto m = Module::from_bytes(R"(
+%Qubit = type opaque
+%Result = type opaque
+
+define void @main() #0 {
+entry:
+  br label %body
+body:
+  %i = phi i64 [ 0, %entry ], [ %next, %body ]
+  call void @__quantum__qis__h__body(%Qubit* null)
+  %next = add i64 %i, 1
+  %done = icmp eq i64 %next, 1000
+  br i1 %done, label %exit, label %body
+exit:
+  call void @__quantum__qis__mz__body(%Qubit* null, %Result* null)
+  ret void
+}
+
+declare void @__quantum__qis__h__body(%Qubit*)
+declare void @__quantum__qis__mz__body(%Qubit*, %Result*)
+
+attributes #0 = { "entry_point" "required_num_qubits"="1" "required_num_results"="1" }
+)");
+    options.buffer_gates = true;
+    options.opt_level = OptLevel::O2;
+    Executor execute(std::move(*m), options);
+    EXPECT_EQ(1, execute.stats().optimization.gates_buffered);
+
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    ResultTestImpl result_impl(&tr);
+    execute(quantum_impl, result_impl);
+
+    std::string expected = "\nset_up(q=1, r=1)\n";
+    for (int i = 0; i < 1000; ++i)
+    {
+        expected += "h(Q{0})\n";
+    }
+    expected += "mz(Q{0},R{0})\ntear_down\n";
+    EXPECT_EQ(expected, tr.commands.str());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, object_cache)
+{
+    for (auto engine : {JitEngine::mcjit, JitEngine::orc, JitEngine::orc_lazy})
+    {
+        SCOPED_TRACE(to_cstring(engine));
+        options.engine = engine;
+        options.cache_dir = std::string("executor-cache-") + to_cstring(engine);
+        std::filesystem::remove_all(options.cache_dir);
+
+        auto run_cached = [this](ExecutorStats* stats) {
+            Executor execute(Module(this->test_data_path("loop.ll")), options);
+            TestResult tr;
+            QuantumTestImpl quantum_impl(&tr);
+            ResultTestImpl result_impl(&tr);
+            execute(quantum_impl, result_impl);
+            *stats = execute.stats();
+            return tr.commands.str();
+        };
+
+        // Cold start compiles and saves the objects
+        ExecutorStats cold;
+        auto expected = run_cached(&cold);
+        EXPECT_EQ(0, cold.cache_hits);
+        EXPECT_LT(0, cold.cache_misses);
+        EXPECT_FALSE(std::filesystem::is_empty(options.cache_dir));
+
+        // Warm start loads every object without compiling
+        ExecutorStats warm;
+        EXPECT_EQ(expected, run_cached(&warm));
+        EXPECT_EQ(cold.cache_misses, warm.cache_hits);
+        EXPECT_EQ(0, warm.cache_misses);
+
+        std::filesystem::remove_all(options.cache_dir);
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, unimplemented)
+{
+    auto m = Module::from_bytes(R"(
+%Qubit = type opaque
+
+define void @main() #0 {
+  call void @__quantum__qis__fredkin__body(%Qubit* null)
+  ret void
+}
+
+declare void @__quantum__qis__fredkin__body(%Qubit*)
+
+attributes #0 = { "entry_point" }
+)");
+
+    // Unbound functions are rejected before anything is compiled
+    EXPECT_THROW(Executor(std::move(*m), options), DebugError);
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, execution_class)
+{
+    auto get_class = [this](char const* filename) {
+        Executor execute(Module(this->test_data_path(filename)), options);
+        return execute.execution_class();
+    };
+    EXPECT_EQ(ExecutionClass::static_circuit, get_class("bell.ll"));
+    EXPECT_EQ(ExecutionClass::static_circuit, get_class("lazy.bc"));
+    EXPECT_EQ(ExecutionClass::dynamic_circuit, get_class("teleport.ll"));
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, dynamic_qubits)
+{
+    auto m = Module::from_bytes(R"(
+%Qubit = type opaque
+%Result = type opaque
+
+define void @main() #0 {
+  %a = call %Qubit* @__quantum__rt__qubit_allocate()
+  %b = call %Qubit* @__quantum__rt__qubit_allocate()
+  call void @__quantum__qis__h__body(%Qubit* %a)
+  call void @__quantum__qis__cnot__body(%Qubit* %a, %Qubit* %b)
+  call void @__quantum__rt__qubit_release(%Qubit* %a)
+  %c = call %Qubit* @__quantum__rt__qubit_allocate()
+  call void @__quantum__qis__h__body(%Qubit* %c)
+  call void @__quantum__qis__mz__body(%Qubit* %c, %Result* null)
+  call void @__quantum__rt__qubit_release(%Qubit* %b)
+  call void @__quantum__rt__qubit_release(%Qubit* %c)
+  call void @__quantum__rt__result_record_output(%Result* null, i8* null)
+  ret void
+}
+
+declare %Qubit* @__quantum__rt__qubit_allocate()
+declare void @__quantum__rt__qubit_release(%Qubit*)
+declare void @__quantum__qis__h__body(%Qubit*)
+declare void @__quantum__qis__cnot__body(%Qubit*, %Qubit*)
+declare void @__quantum__qis__mz__body(%Qubit*, %Result*)
+declare void @__quantum__rt__result_record_output(%Result*, i8*)
+
+attributes #0 = { "entry_point" "required_num_results"="1" }
+)");
+    Executor execute(std::move(*m), options);
+    EXPECT_EQ(ExecutionClass::static_circuit, execute.execution_class());
+
+    // Backend is sized for the peak number of live qubits, and every shot
+    // reuses the released index
+    std::string const shot = R"(set_up(q=2, r=1)
+h(Q{0})
+cnot(Q{0}, Q{1})
+h(Q{0})
+mz(Q{0},R{0})
+result_record_output(R{0})
+tear_down
+)";
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    ResultTestImpl result_impl(&tr);
+    execute.run_shots(quantum_impl, result_impl, 2, {});
+    EXPECT_EQ("\n" + shot + shot, tr.commands.str());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, adaptive_dynamic_qubits)
+{
+    auto m = Module::from_bytes(R"(
+%Qubit = type opaque
+%Result = type opaque
+
+define void @main() #0 {
+entry:
+  %a = call %Qubit* @__quantum__rt__qubit_allocate()
+  %b = call %Qubit* @__quantum__rt__qubit_allocate()
+  call void @__quantum__qis__h__body(%Qubit* %a)
+  %r = call %Result* @__quantum__qis__m__body(%Qubit* %a)
+  %one = call %Result* @__quantum__rt__result_get_one()
+  %is_one = call i1 @__quantum__rt__result_equal(%Result* %r, %Result* %one)
+  br i1 %is_one, label %then, label %exit
+then:
+  %c = call %Qubit* @__quantum__rt__qubit_allocate()
+  call void @__quantum__qis__cnot__body(%Qubit* %c, %Qubit* %b)
+  call void @__quantum__rt__qubit_release(%Qubit* %c)
+  br label %exit
+exit:
+  %s = call %Result* @__quantum__qis__mresetz__body(%Qubit* %b)
+  call void @__quantum__rt__result_record_output(%Result* %s, i8* null)
+  call void @__quantum__rt__qubit_release(%Qubit* %a)
+  call void @__quantum__rt__qubit_release(%Qubit* %b)
+  ret void
+}
+
+declare %Qubit* @__quantum__rt__qubit_allocate()
+declare void @__quantum__rt__qubit_release(%Qubit*)
+declare void @__quantum__qis__h__body(%Qubit*)
+declare void @__quantum__qis__cnot__body(%Qubit*, %Qubit*)
+declare %Result* @__quantum__qis__m__body(%Qubit*)
+declare %Result* @__quantum__qis__mresetz__body(%Qubit*)
+declare %Result* @__quantum__rt__result_get_one()
+declare i1 @__quantum__rt__result_equal(%Result*, %Result*)
+declare void @__quantum__rt__result_record_output(%Result*, i8*)
+
+attributes #0 = { "entry_point" }
+)");
+    Executor execute(std::move(*m), options);
+    EXPECT_EQ(ExecutionClass::dynamic_circuit, execute.execution_class());
+
+    // The branch depends on a measurement, so the backend is sized for every
+    // allocation and measurement on any path; measurement results are
+    // renumbered every shot
+    EXPECT_EQ(3, execute.entry_point_attrs().required_num_qubits);
+    EXPECT_EQ(2, execute.entry_point_attrs().required_num_results);
+    std::string const shot = R"(set_up(q=3, r=2)
+h(Q{0})
+mz(Q{0},R{0})
+read_result(R{0})
+mz(Q{1},R{1})
+TODO: reset.body
+result_record_output(R{1})
+tear_down
+)";
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    ResultTestImpl result_impl(&tr);
+    execute.run_shots(quantum_impl, result_impl, 2, {});
+    EXPECT_EQ("\n" + shot + shot, tr.commands.str());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, unbounded_dynamic_qubits)
+{
+    // Allocations in a loop that ends on a measurement can't be bounded
+    char const loop_ir[] = R"(
+%Qubit = type opaque
+%Result = type opaque
+
+define void @main() #0 {
+entry:
+  br label %loop
+loop:
+  %q = call %Qubit* @__quantum__rt__qubit_allocate()
+  call void @__quantum__qis__mz__body(%Qubit* %q, %Result* null)
+  %done = call i1 @__quantum__qis__read_result__body(%Result* null)
+  br i1 %done, label %exit, label %loop
+exit:
+  ret void
+}
+
+declare %Qubit* @__quantum__rt__qubit_allocate()
+declare void @__quantum__qis__mz__body(%Qubit*, %Result*)
+declare i1 @__quantum__qis__read_result__body(%Result*)
+
+attributes #0 = { "entry_point" "required_num_results"="1" )";
+    auto m = Module::from_bytes(std::string(loop_ir) + "}\n");
+    EXPECT_THROW(Executor(std::move(*m), options), RuntimeError);
+
+    // A declared number of qubits is used instead, and exceeding it at run
+    // time is an error (the test backend always measures zero)
+    m = Module::from_bytes(std::string(loop_ir)
+                           + "\"required_num_qubits\"=\"2\" }\n");
+    Executor execute(std::move(*m), options);
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    ResultTestImpl result_impl(&tr);
+    EXPECT_THROW(execute(quantum_impl, result_impl), RuntimeError);
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, dynamic_results)
+{
+    auto m = Module::from_bytes(R"(
+%Qubit = type opaque
+%Result = type opaque
+
+define void @main() #0 {
+entry:
+  call void @__quantum__qis__mz__body(%Qubit* null, %Result* null)
+  %one = call %Result* @__quantum__rt__result_get_one()
+  %zero = call %Result* @__quantum__rt__result_get_zero()
+  call void @__quantum__rt__result_update_reference_count(%Result* %one, i32 1)
+  %same = call i1 @__quantum__rt__result_equal(%Result* %one, %Result* %one)
+  %differ = call i1 @__quantum__rt__result_equal(%Result* %one, %Result* %zero)
+  br i1 %same, label %check, label %exit
+check:
+  br i1 %differ, label %exit, label %measured
+measured:
+  %is_one = call i1 @__quantum__rt__result_equal(%Result* null, %Result* %one)
+  br i1 %is_one, label %flip, label %exit
+flip:
+  call void @__quantum__qis__x__body(%Qubit* null)
+  br label %exit
+exit:
+  call void @__quantum__rt__result_update_reference_count(%Result* %one, i32 -1)
+  ret void
+}
+
+declare void @__quantum__qis__mz__body(%Qubit*, %Result*)
+declare void @__quantum__qis__x__body(%Qubit*)
+declare %Result* @__quantum__rt__result_get_one()
+declare %Result* @__quantum__rt__result_get_zero()
+declare i1 @__quantum__rt__result_equal(%Result*, %Result*)
+declare void @__quantum__rt__result_update_reference_count(%Result*, i32)
+
+attributes #0 = { "entry_point" "required_num_qubits"="1" "required_num_results"="1" }
+)");
+    Executor execute(std::move(*m), options);
+    EXPECT_EQ(ExecutionClass::dynamic_circuit, execute.execution_class());
+    EXPECT_FALSE(execute.shot_invariant());
+
+    // Constant results are compared without the backend; the test backend
+    // measures zero, so the X gate is skipped
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    ResultTestImpl result_impl(&tr);
+    execute(quantum_impl, result_impl);
+    EXPECT_EQ(R"(
+set_up(q=1, r=1)
+mz(Q{0},R{0})
+read_result(R{0})
+tear_down
+)",
+              tr.commands.str());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, constant_results)
+{
+    // Constant results are read and recorded without the backend
+    auto result = this->run("constant_results.ll");
+    EXPECT_EQ(R"(
+set_up(q=1, r=1)
+h(Q{0})
+mz(Q{0},R{0})
+array_record_output(3)
+result_record_output(R{0})
+constant_record_output(1)
+constant_record_output(0)
+tear_down
+)",
+              result.commands.str());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ExecutorTest, lazy_bitcode)
+{
+    // Text IR is fully loaded, so the unimplemented call in an unused
+    // function is rejected
+    EXPECT_THROW(Executor(Module(this->test_data_path("lazy.ll")), options),
+                 DebugError);
+
+    auto const expected = this->run("bell.ll").commands.str();
+    for (auto engine : {JitEngine::mcjit, JitEngine::orc, JitEngine::orc_lazy})
+    {
+        SCOPED_TRACE(to_cstring(engine));
+        options.engine = engine;
+
+        // Only functions reachable from the entry point are read
+        Executor execute(Module(this->test_data_path("lazy.bc")), options);
+        EXPECT_EQ(1, execute.stats().unloaded_functions);
+
+        TestResult tr;
+        QuantumTestImpl quantum_impl(&tr);
+        ResultTestImpl result_impl(&tr);
+        execute(quantum_impl, result_impl);
+        EXPECT_EQ(expected, tr.commands.str());
+    }
+
+    // Fully loaded modules are unchanged
+    Executor execute(Module(this->test_data_path("bell.ll")), options);
+    EXPECT_EQ(0, execute.stats().unloaded_functions);
+}
+
 //---------------------------------------------------------------------------//
 }  // namespace test
 }  // namespace qiree
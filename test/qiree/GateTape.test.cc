@@ -0,0 +1,418 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/GateTape.test.cc
+//---------------------------------------------------------------------------//
+#include "qiree/GateTape.hh"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "QuantumTestImpl.hh"
+#include "qiree/Executor.hh"
+#include "qiree/Module.hh"
+#include "qiree/RecordingQuantum.hh"
+#include "qiree/RecordingRuntime.hh"
+#include "qiree_test.hh"
+
+namespace qiree
+{
+namespace test
+{
+//---------------------------------------------------------------------------//
+class GateTapeTest : public ::qiree::test::Test
+{
+  protected:
+    Executor load(std::string const& filename)
+    {
+        return Executor(Module(this->test_data_path(filename)));
+    }
+};
+
+//---------------------------------------------------------------------------//
+TEST_F(GateTapeTest, opcode_strings)
+{
+    EXPECT_STREQ("mz", to_cstring(GateOpCode::mz));
+    EXPECT_STREQ("cnot", to_cstring(GateOpCode::cnot));
+    EXPECT_STREQ("result_record_output",
+                 to_cstring(GateOpCode::result_record_output));
+}
+
+TEST_F(GateTapeTest, storage)
+{
+    GateTape tape;
+    EXPECT_TRUE(tape.empty());
+
+    auto fill = [&tape] {
+        for (size_type i = 0; i < 1000; ++i)
+        {
+            GateOp op;
+            op.code = GateOpCode::rzz;
+            op.ids = {i, i + 1};
+            op.params = {0.5 * i};
+            tape.push_back(op);
+
+            op = {};
+            op.code = GateOpCode::h;
+            op.ids = {i};
+            tape.push_back(op);
+        }
+        GateOp op;
+        op.code = GateOpCode::result_record_output;
+        op.ids = {3};
+        op.tag = "r3";
+        tape.push_back(op);
+    };
+    fill();
+    ASSERT_EQ(2001, tape.size());
+
+    // Parameters span several arena blocks
+    EXPECT_EQ(GateOpCode::rzz, tape.code(1998));
+    EXPECT_EQ(999, tape.ids(1998)[0]);
+    EXPECT_EQ(1000, tape.ids(1998)[1]);
+    EXPECT_DOUBLE_EQ(499.5, tape.params(1998)[0]);
+    EXPECT_EQ(nullptr, tape.tag(1998));
+
+    GateOp op = tape[1999];
+    EXPECT_EQ(GateOpCode::h, op.code);
+    EXPECT_EQ(999, op.ids[0]);
+    EXPECT_EQ(0, op.ids[1]);
+
+    op = tape[2000];
+    EXPECT_EQ(GateOpCode::result_record_output, op.code);
+    EXPECT_EQ(3, op.ids[0]);
+    EXPECT_STREQ("r3", op.tag);
+
+    // Refilling a cleared tape reuses its storage
+    double const* params = tape.params(0);
+    tape.clear();
+    EXPECT_TRUE(tape.empty());
+    fill();
+    EXPECT_EQ(params, tape.params(0));
+    EXPECT_DOUBLE_EQ(499.5, tape.params(1998)[0]);
+}
+
+TEST_F(GateTapeTest, bell)
+{
+    Executor execute = this->load("bell.ll");
+    EXPECT_TRUE(execute.shot_invariant());
+
+    TestResult expected;
+    {
+        QuantumTestImpl quantum_impl(&expected);
+        ResultTestImpl result_impl(&expected);
+        execute(quantum_impl, result_impl);
+    }
+
+    GateTape tape;
+    TestResult recorded;
+    {
+        QuantumTestImpl quantum_impl(&recorded);
+        ResultTestImpl result_impl(&recorded);
+        EXPECT_TRUE(execute.record(quantum_impl, result_impl, &tape));
+    }
+    EXPECT_EQ(expected.commands.str(), recorded.commands.str());
+
+    // h, cnot, 2 x mz, array record, 2 x result record
+    ASSERT_EQ(7, tape.size());
+    EXPECT_EQ(GateOpCode::h, tape[0].code);
+    EXPECT_EQ(GateOpCode::cnot, tape[1].code);
+    EXPECT_EQ(0, tape[1].ids[0]);
+    EXPECT_EQ(1, tape[1].ids[1]);
+
+    TestResult replayed;
+    {
+        QuantumTestImpl quantum_impl(&replayed);
+        ResultTestImpl result_impl(&replayed);
+        execute.replay(tape, quantum_impl, result_impl);
+    }
+    EXPECT_EQ(expected.commands.str(), replayed.commands.str());
+}
+
+TEST_F(GateTapeTest, apply_block)
+{
+    std::vector<GateOp> ops(3);
+    ops[0].code = GateOpCode::h;
+    ops[1].code = GateOpCode::cnot;
+    ops[1].ids = {0, 1};
+    ops[2].code = GateOpCode::mz;
+    ops[2].ids = {1, 0};
+
+    // Default implementation calls each gate
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    GateTape tape;
+    RecordingQuantum recording(quantum_impl, &tape);
+    recording.apply(ops);
+    EXPECT_EQ(R"(
+h(Q{0})
+cnot(Q{0}, Q{1})
+mz(Q{1},R{0})
+)",
+              tr.commands.str());
+
+    // Block is recorded
+    ASSERT_EQ(3, tape.size());
+    EXPECT_EQ(GateOpCode::cnot, tape[1].code);
+    EXPECT_EQ(1, tape[2].ids[0]);
+}
+
+TEST_F(GateTapeTest, rotation)
+{
+    Executor execute = this->load("rotation.ll");
+    EXPECT_TRUE(execute.shot_invariant());
+
+    TestResult expected;
+    {
+        QuantumTestImpl quantum_impl(&expected);
+        ResultTestImpl result_impl(&expected);
+        execute(quantum_impl, result_impl);
+    }
+
+    GateTape tape;
+    {
+        TestResult tr;
+        QuantumTestImpl quantum_impl(&tr);
+        ResultTestImpl result_impl(&tr);
+        EXPECT_TRUE(execute.record(quantum_impl, result_impl, &tape));
+    }
+
+    TestResult replayed;
+    {
+        QuantumTestImpl quantum_impl(&replayed);
+        ResultTestImpl result_impl(&replayed);
+        execute.replay(tape, quantum_impl, result_impl);
+    }
+    EXPECT_EQ(expected.commands.str(), replayed.commands.str());
+}
+
+TEST_F(GateTapeTest, constant_record_output)
+{
+    GateTape tape;
+    TestResult recorded;
+    {
+        QuantumTestImpl quantum_impl(&recorded);
+        ResultTestImpl result_impl(&recorded);
+        RecordingRuntime runtime(result_impl, &tape);
+        runtime.array_record_output(2, nullptr);
+        runtime.constant_record_output(QState::one, "c");
+        runtime.constant_record_output(QState::zero, nullptr);
+    }
+    EXPECT_EQ(R"(
+array_record_output(2)
+constant_record_output(1, c)
+constant_record_output(0)
+)",
+              recorded.commands.str());
+
+    // Constant results store their value in place of a result handle
+    ASSERT_EQ(3, tape.size());
+    EXPECT_EQ(GateOpCode::constant_record_output, tape[1].code);
+    EXPECT_EQ(1, tape[1].ids[0]);
+    EXPECT_EQ(0, tape[2].ids[0]);
+
+    TestResult replayed;
+    {
+        QuantumTestImpl quantum_impl(&replayed);
+        ResultTestImpl result_impl(&replayed);
+        replay(tape, quantum_impl, result_impl);
+    }
+    EXPECT_EQ(recorded.commands.str(), replayed.commands.str());
+}
+
+TEST_F(GateTapeTest, teleport)
+{
+    Executor execute = this->load("teleport.ll");
+    EXPECT_FALSE(execute.shot_invariant());
+
+    // Recording still executes the program but marks it as non-replayable
+    GateTape tape;
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    ResultTestImpl result_impl(&tr);
+    EXPECT_FALSE(execute.record(quantum_impl, result_impl, &tape));
+    EXPECT_FALSE(tape.empty());
+}
+
+TEST_F(GateTapeTest, compact_qubits)
+{
+    GateTape tape;
+    auto add = [&tape](GateOpCode code,
+                       std::initializer_list<size_type> ids,
+                       double param = 0) {
+        GateOp op;
+        op.code = code;
+        std::copy(ids.begin(), ids.end(), op.ids.begin());
+        op.params[0] = param;
+        tape.push_back(op);
+    };
+    auto to_string = [](GateTape const& t) {
+        std::string result;
+        for (size_type i = 0; i < t.size(); ++i)
+        {
+            result += to_cstring(t.code(i));
+            for (size_type j = 0; j < num_ids(t.code(i)); ++j)
+            {
+                result += ' ' + std::to_string(t.ids(i)[j]);
+            }
+            result += ';';
+        }
+        return result;
+    };
+
+    using GOC = GateOpCode;
+    add(GOC::h, {0});
+    add(GOC::mz, {0, 0});
+    add(GOC::h, {1});
+    add(GOC::x, {2});
+    add(GOC::cnot, {1, 2});
+    add(GOC::reset, {2});
+    add(GOC::mz, {1, 1});
+    add(GOC::h, {3});
+    add(GOC::cx, {3, 4});
+    add(GOC::rx, {4}, 0.5);
+    add(GOC::result_record_output, {1});
+
+    // Measured qubits are reset before reuse; reset qubits are reused as is
+    GateTape compacted;
+    EXPECT_EQ(2, compact_qubits(tape, &compacted));
+    EXPECT_EQ(
+        "h 0;mz 0 0;reset 0;h 0;x 1;cnot 0 1;reset 1;mz 0 1;h 1;reset 0;"
+        "cx 1 0;rx 0;result_record_output 1;",
+        to_string(compacted));
+    EXPECT_DOUBLE_EQ(0.5, compacted.params(11)[0]);
+
+    // Qubits in arrays are unknown
+    add(GOC::h_ctl, {0, 1});
+    GateTape unchanged;
+    EXPECT_EQ(0, compact_qubits(tape, &unchanged));
+    EXPECT_TRUE(unchanged.empty());
+}
+
+TEST_F(GateTapeTest, prune_lightcone)
+{
+    GateTape tape;
+    auto add = [&tape](GateOpCode code, std::initializer_list<size_type> ids) {
+        GateOp op;
+        op.code = code;
+        std::copy(ids.begin(), ids.end(), op.ids.begin());
+        tape.push_back(op);
+    };
+
+    using GOC = GateOpCode;
+    add(GOC::h, {0});
+    add(GOC::h, {1});
+    add(GOC::cnot, {1, 0});
+    add(GOC::x, {1});  // Unused after
+    add(GOC::reset, {0});  // Earlier gates on q0 are irrelevant
+    add(GOC::h, {2});
+    add(GOC::cz, {2, 0});
+    add(GOC::mz, {0, 0});
+    add(GOC::mz, {2, 1});  // Not recorded
+    add(GOC::array_record_output, {1});
+    add(GOC::result_record_output, {0});
+
+    GateTape pruned;
+    EXPECT_EQ(5, prune_lightcone(tape, &pruned));
+    std::vector<GateOpCode> expected{GOC::reset,
+                                     GOC::h,
+                                     GOC::cz,
+                                     GOC::mz,
+                                     GOC::array_record_output,
+                                     GOC::result_record_output};
+    EXPECT_EQ(expected, pruned.codes());
+    EXPECT_EQ(2, pruned.ids(1)[0]);
+
+    // Operations before a controlled gate are all kept
+    tape.clear();
+    add(GOC::h, {1});
+    add(GOC::x_ctl, {0, 1});
+    add(GOC::h, {1});
+    add(GOC::result_record_output, {0});
+    EXPECT_EQ(1, prune_lightcone(tape, &pruned));
+    EXPECT_EQ(3, pruned.size());
+}
+
+TEST_F(GateTapeTest, compact_bell)
+{
+    Executor execute = this->load("bell.ll");
+
+    GateTape tape;
+    TestResult expected;
+    {
+        QuantumTestImpl quantum_impl(&expected);
+        ResultTestImpl result_impl(&expected);
+        EXPECT_TRUE(execute.record(quantum_impl, result_impl, &tape));
+    }
+
+    // Both qubits are live until the end
+    GateTape compacted;
+    ASSERT_EQ(2, compact_qubits(tape, &compacted));
+
+    TestResult replayed;
+    {
+        QuantumTestImpl quantum_impl(&replayed);
+        ResultTestImpl result_impl(&replayed);
+        execute.replay(compacted, 2, quantum_impl, result_impl);
+    }
+    EXPECT_EQ(expected.commands.str(), replayed.commands.str());
+}
+
+TEST_F(GateTapeTest, split_terminal_measurements)
+{
+    Executor execute = this->load("bell.ll");
+
+    GateTape tape;
+    {
+        TestResult tr;
+        QuantumTestImpl quantum_impl(&tr);
+        ResultTestImpl result_impl(&tr);
+        EXPECT_TRUE(execute.record(quantum_impl, result_impl, &tape));
+    }
+
+    using GOC = GateOpCode;
+    GateTape gates;
+    GateTape outputs;
+    EXPECT_TRUE(split_terminal_measurements(tape, &gates, &outputs));
+    EXPECT_EQ((std::vector<GOC>{GOC::h, GOC::cnot}), gates.codes());
+    EXPECT_EQ((std::vector<GOC>{GOC::mz,
+                                GOC::mz,
+                                GOC::array_record_output,
+                                GOC::result_record_output,
+                                GOC::result_record_output}),
+              outputs.codes());
+
+    auto add = [&tape](GateOpCode code, std::initializer_list<size_type> ids) {
+        GateOp op;
+        op.code = code;
+        std::copy(ids.begin(), ids.end(), op.ids.begin());
+        tape.push_back(op);
+    };
+
+    // Gate on a measured qubit
+    tape.clear();
+    add(GOC::h, {0});
+    add(GOC::mz, {0, 0});
+    add(GOC::h, {1});
+    add(GOC::x, {0});
+    EXPECT_FALSE(split_terminal_measurements(tape, &gates, &outputs));
+
+    // Result recorded before it is measured
+    tape.clear();
+    add(GOC::result_record_output, {0});
+    add(GOC::mz, {0, 0});
+    EXPECT_FALSE(split_terminal_measurements(tape, &gates, &outputs));
+
+    // Two results from one qubit
+    tape.clear();
+    add(GOC::mz, {0, 0});
+    add(GOC::mz, {0, 1});
+    EXPECT_FALSE(split_terminal_measurements(tape, &gates, &outputs));
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace test
+}  // namespace qiree
@@ -11,7 +11,10 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "qiree/Assert.hh"
 #include "qiree_test.hh"
 
 namespace qiree
@@ -24,8 +27,21 @@ class ModuleTest : public ::qiree::test::Test
 {
   protected:
     void SetUp() override {}
+
+    static std::string read_file(std::string const& path);
 };
 
+//---------------------------------------------------------------------------//
+std::string ModuleTest::read_file(std::string const& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Cannot open file: " + path);
+    std::ostringstream buf;
+    buf << file.rdbuf();
+    return buf.str();
+}
+
 //---------------------------------------------------------------------------//
 TEST_F(ModuleTest, minimal)
 {
@@ -141,6 +157,226 @@ TEST_F(ModuleTest, parse_ir_from_file)
         << "QIR should contain a !llvm.module.flags metadata node";
 }
 
+//---------------------------------------------------------------------------//
+TEST_F(ModuleTest, from_bytes)
+{
+    // Bitcode is parsed in place
+    std::string bc = read_file(this->test_data_path("bell.bc"));
+    auto m = Module::from_bytes(bc);
+    ASSERT_TRUE(m && *m);
+    EXPECT_EQ(2, m->load_entry_point_attrs().required_num_qubits);
+
+    // Text with a trailing null is parsed in place
+    std::string ir = read_file(this->test_data_path("bell.ll"));
+    m = Module::from_bytes(std::string_view(ir.c_str(), ir.size() + 1));
+    ASSERT_TRUE(m && *m);
+    EXPECT_EQ(2, m->load_entry_point_attrs().required_num_results);
+
+    // Errors report the size rather than the content
+    std::string const bad = "this is not QIR";
+    try
+    {
+        Module::from_bytes(bad);
+        FAIL() << "expected an exception";
+    }
+    catch (RuntimeError const& e)
+    {
+        std::string const msg = e.what();
+        EXPECT_EQ(std::string::npos, msg.find(bad)) << msg;
+        EXPECT_NE(std::string::npos, msg.find("15 bytes")) << msg;
+    }
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ModuleTest, link)
+{
+    auto m = Module::from_bytes(R"(
+%Qubit = type opaque
+
+define void @main() #0 {
+  call void @prepare(%Qubit* null)
+  ret void
+}
+
+declare void @prepare(%Qubit*)
+
+attributes #0 = { "entry_point" "required_num_qubits"="1" }
+)");
+    EXPECT_EQ(0, m->num_linked());
+
+    // Libraries may call into previously linked libraries
+    m->link_bytes(R"(
+%Qubit = type opaque
+
+define void @rotate(%Qubit* %q) {
+  call void @__quantum__qis__h__body(%Qubit* %q)
+  ret void
+}
+
+declare void @__quantum__qis__h__body(%Qubit*)
+)");
+    m->link_bytes(R"(
+%Qubit = type opaque
+
+define void @prepare(%Qubit* %q) {
+  call void @rotate(%Qubit* %q)
+  ret void
+}
+
+declare void @rotate(%Qubit*)
+)");
+    EXPECT_EQ(2, m->num_linked());
+    EXPECT_EQ(1, m->load_entry_point_attrs().required_num_qubits);
+    EXPECT_EQ(ExecutionClass::static_circuit, m->execution_class());
+
+    // Redefining a function is an error
+    try
+    {
+        m->link_bytes(R"(
+define void @rotate(i8* %q) {
+  ret void
+}
+)");
+        FAIL() << "expected an exception";
+    }
+    catch (RuntimeError const& e)
+    {
+        std::string const msg = e.what();
+        EXPECT_NE(std::string::npos, msg.find("rotate")) << msg;
+    }
+
+    EXPECT_THROW(m->link(this->test_data_path("nonexistent.bc")),
+                 RuntimeError);
+}
+
+TEST_F(ModuleTest, bitcode_file)
+{
+    Module m(this->test_data_path("bell.bc"));
+    ASSERT_TRUE(m);
+    EXPECT_EQ(2, m.load_entry_point_attrs().required_num_qubits);
+
+    EXPECT_THROW(Module(this->test_data_path("nonexistent.bc")),
+                 RuntimeError);
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ModuleTest, execution_class)
+{
+    EXPECT_STREQ("static", to_cstring(ExecutionClass::static_circuit));
+
+    auto get_class = [this](char const* filename) {
+        return Module(this->test_data_path(filename)).execution_class();
+    };
+    EXPECT_EQ(ExecutionClass::static_circuit, get_class("bell.ll"));
+    EXPECT_EQ(ExecutionClass::static_circuit, get_class("lazy.bc"));
+    EXPECT_EQ(ExecutionClass::static_circuit, get_class("loop.ll"));
+    EXPECT_EQ(ExecutionClass::dynamic_circuit, get_class("teleport.ll"));
+
+    auto from_body = [](std::string const& body) {
+        return Module::from_bytes(R"(
+%Qubit = type opaque
+%Result = type opaque
+
+declare i1 @__quantum__qis__read_result__body(%Result*)
+declare %Result* @__quantum__qis__m__body(%Qubit*)
+declare void @__quantum__qis__h__body(%Qubit*)
+declare void @__quantum__qis__rx__body(double, %Qubit*)
+declare void @__quantum__rt__bool_record_output(i1, i8*)
+declare void @__quantum__rt__result_record_output(%Result*, i8*)
+
+define internal void @flip(i1 %b) {
+  br i1 %b, label %then, label %done
+then:
+  call void @__quantum__qis__h__body(%Qubit* null)
+  br label %done
+done:
+  ret void
+}
+
+attributes #0 = { "entry_point" }
+
+define void @main() #0 {
+)" + body + "\n  ret void\n}\n");
+    };
+
+    // Outcomes that are only recorded keep the circuit static
+    auto m = from_body(R"(
+  %r = call %Result* @__quantum__qis__m__body(%Qubit* null)
+  call void @__quantum__rt__result_record_output(%Result* %r, i8* null)
+  %b = call i1 @__quantum__qis__read_result__body(%Result* %r)
+  call void @__quantum__rt__bool_record_output(i1 %b, i8* null))");
+    EXPECT_EQ(ExecutionClass::static_circuit, m->execution_class());
+
+    // Branching in a called function
+    m = from_body(R"(
+  %r = call %Result* @__quantum__qis__m__body(%Qubit* null)
+  %b = call i1 @__quantum__qis__read_result__body(%Result* %r)
+  call void @flip(i1 %b))");
+    EXPECT_EQ(ExecutionClass::dynamic_circuit, m->execution_class());
+
+    // Gate argument computed from an outcome stored on the stack
+    m = from_body(R"(
+  %x = alloca double
+  %b = call i1 @__quantum__qis__read_result__body(%Result* null)
+  %t = uitofp i1 %b to double
+  store double %t, double* %x
+  %y = load double, double* %x
+  call void @__quantum__qis__rx__body(double %y, %Qubit* null))");
+    EXPECT_EQ(ExecutionClass::dynamic_circuit, m->execution_class());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(ModuleTest, concurrent)
+{
+    // Each module has its own context, so loading is fully parallel
+    std::vector<std::string> const filenames{
+        "bell.ll", "bell.bc", "lazy.bc", "rotation.ll", "teleport.ll"};
+    std::string const bc = read_file(this->test_data_path("bell.bc"));
+
+    constexpr int num_threads = 8;
+    std::vector<std::vector<size_type>> num_qubits(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t] {
+            for (int rep = 0; rep < 4; ++rep)
+            {
+                for (auto const& fn : filenames)
+                {
+                    Module m(this->test_data_path(fn));
+                    num_qubits[t].push_back(
+                        m.load_entry_point_attrs().required_num_qubits);
+                }
+                auto m = Module::from_bytes(bc);
+                num_qubits[t].push_back(
+                    m->load_entry_point_attrs().required_num_qubits);
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    std::vector<size_type> expected;
+    for (auto const& fn : filenames)
+    {
+        expected.push_back(Module(this->test_data_path(fn))
+                               .load_entry_point_attrs()
+                               .required_num_qubits);
+    }
+    expected.push_back(2);
+    for (int rep = 1; rep < 4; ++rep)
+    {
+        expected.insert(
+            expected.end(), expected.begin(), expected.begin() + 6);
+    }
+    for (auto const& actual : num_qubits)
+    {
+        EXPECT_EQ(expected, actual);
+    }
+}
+
 //---------------------------------------------------------------------------//
 }  // namespace test
 }  // namespace qiree
@@ -0,0 +1,113 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/PermutedQuantum.test.cc
+//---------------------------------------------------------------------------//
+#include "qiree/PermutedQuantum.hh"
+
+#include "QuantumTestImpl.hh"
+#include "qiree/Assert.hh"
+#include "qiree/CircuitAnalysis.hh"
+#include "qiree/Executor.hh"
+#include "qiree/Module.hh"
+#include "qiree_test.hh"
+
+namespace qiree
+{
+namespace test
+{
+//---------------------------------------------------------------------------//
+
+class PermutedQuantumTest : public ::qiree::test::Test
+{
+  protected:
+    using VecIndex = PermutedQuantum::VecIndex;
+
+    static std::unique_ptr<Module> make_module()
+    {
+        return Module::from_bytes(R"(
+%Qubit = type opaque
+%Result = type opaque
+
+define void @main() #0 {
+  call void @__quantum__qis__h__body(%Qubit* inttoptr (i64 2 to %Qubit*))
+  call void @__quantum__qis__cnot__body(%Qubit* inttoptr (i64 3 to %Qubit*), %Qubit* inttoptr (i64 1 to %Qubit*))
+  call void @__quantum__qis__cnot__body(%Qubit* inttoptr (i64 1 to %Qubit*), %Qubit* inttoptr (i64 3 to %Qubit*))
+  call void @__quantum__qis__cnot__body(%Qubit* null, %Qubit* inttoptr (i64 3 to %Qubit*))
+  call void @__quantum__qis__mz__body(%Qubit* inttoptr (i64 3 to %Qubit*), %Result* null)
+  call void @__quantum__qis__mz__body(%Qubit* inttoptr (i64 2 to %Qubit*), %Result* inttoptr (i64 1 to %Result*))
+  call void @__quantum__rt__result_record_output(%Result* null, i8* null)
+  call void @__quantum__rt__result_record_output(%Result* inttoptr (i64 1 to %Result*), i8* null)
+  ret void
+}
+
+declare void @__quantum__qis__h__body(%Qubit*)
+declare void @__quantum__qis__cnot__body(%Qubit*, %Qubit*)
+declare void @__quantum__qis__mz__body(%Qubit*, %Result*)
+declare void @__quantum__rt__result_record_output(%Result*, i8*)
+
+attributes #0 = { "entry_point" "required_num_qubits"="4" "required_num_results"="2" }
+)");
+    }
+};
+
+//---------------------------------------------------------------------------//
+TEST_F(PermutedQuantumTest, locality_permutation)
+{
+    auto m = make_module();
+    CircuitAnalysis analysis{*m};
+    ASSERT_TRUE(analysis.complete());
+
+    // Qubit 3 interacts most, then 1 (twice with 3), then 0; 2 only has
+    // single-qubit operations
+    EXPECT_EQ((VecIndex{2, 1, 3, 0}), locality_permutation(analysis));
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(PermutedQuantumTest, execute)
+{
+    auto m = make_module();
+    VecIndex perm = locality_permutation(CircuitAnalysis{*m});
+    Executor execute{std::move(*m)};
+
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    ResultTestImpl result_impl(&tr);
+    PermutedQuantum permuted(quantum_impl, perm);
+    execute(permuted, result_impl);
+
+    // Qubits are relabeled but results keep their IDs
+    EXPECT_EQ(R"(
+set_up(q=4, r=2)
+h(Q{3})
+cnot(Q{0}, Q{1})
+cnot(Q{1}, Q{0})
+cnot(Q{2}, Q{0})
+mz(Q{0},R{0})
+mz(Q{3},R{1})
+result_record_output(R{0})
+result_record_output(R{1})
+tear_down
+)",
+              tr.commands.str());
+}
+
+//---------------------------------------------------------------------------//
+TEST_F(PermutedQuantumTest, errors)
+{
+    TestResult tr;
+    QuantumTestImpl quantum_impl(&tr);
+    EXPECT_THROW(PermutedQuantum(quantum_impl, {0, 2}), RuntimeError);
+    EXPECT_THROW(PermutedQuantum(quantum_impl, {1, 1}), RuntimeError);
+
+    // Qubits beyond the permutation are unchanged
+    PermutedQuantum permuted(quantum_impl, {1, 0});
+    permuted.cnot(Qubit{0}, Qubit{2});
+    EXPECT_EQ("\ncnot(Q{1}, Q{2})\n", tr.commands.str());
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace test
+}  // namespace qiree
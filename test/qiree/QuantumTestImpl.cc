@@ -322,6 +322,20 @@ void ResultTestImpl::result_record_output(Result result, OptionalCString tag)
     tr_->commands << ")\n";
 }
 
+//---------------------------------------------------------------------------//
+/*!
+ * Store one constant result
+ */
+void ResultTestImpl::constant_record_output(QState value, OptionalCString tag)
+{
+    tr_->commands << "constant_record_output(" << static_cast<int>(value);
+    if (tag)
+    {
+        tr_->commands << ", " << tag;
+    }
+    tr_->commands << ")\n";
+}
+
 //---------------------------------------------------------------------------//
 }  // namespace test
 }  // namespace qiree
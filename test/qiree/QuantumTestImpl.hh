@@ -131,6 +131,9 @@ class ResultTestImpl final : public RuntimeInterface
     // Store one result
     void result_record_output(Result, OptionalCString tag) final;
 
+    // Store one constant result
+    void constant_record_output(QState, OptionalCString tag) final;
+
   private:
     TestResult* tr_;
 };
@@ -0,0 +1,72 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/QubitPool.test.cc
+//---------------------------------------------------------------------------//
+#include "qiree/QubitPool.hh"
+
+#include "qiree/Assert.hh"
+#include "qiree_test.hh"
+
+namespace qiree
+{
+namespace test
+{
+//---------------------------------------------------------------------------//
+TEST(QubitPoolTest, reuse)
+{
+    QubitPool pool;
+    EXPECT_EQ(0, pool.capacity());
+
+    Qubit a = pool.allocate();
+    Qubit b = pool.allocate();
+    EXPECT_EQ(0, a.value);
+    EXPECT_EQ(1, b.value);
+    EXPECT_EQ(2, pool.num_allocated());
+
+    // Released indices are reused, most recent first
+    pool.release(a);
+    pool.release(b);
+    EXPECT_EQ(0, pool.num_allocated());
+    EXPECT_EQ(1, pool.allocate().value);
+    EXPECT_EQ(0, pool.allocate().value);
+    EXPECT_EQ(2, pool.allocate().value);
+    EXPECT_EQ(3, pool.capacity());
+
+    pool.clear();
+    EXPECT_EQ(0, pool.capacity());
+    EXPECT_EQ(0, pool.allocate().value);
+}
+
+//---------------------------------------------------------------------------//
+TEST(QubitPoolTest, bounded)
+{
+    // Many short-lived qubits use a single index
+    QubitPool pool;
+    Qubit anchor = pool.allocate();
+    for (int i = 0; i < 1000; ++i)
+    {
+        Qubit q = pool.allocate();
+        EXPECT_EQ(1, q.value);
+        pool.release(q);
+    }
+    EXPECT_EQ(2, pool.capacity());
+    EXPECT_EQ(1, pool.num_allocated());
+    EXPECT_EQ(0, anchor.value);
+}
+
+//---------------------------------------------------------------------------//
+TEST(QubitPoolTest, errors)
+{
+    QubitPool pool;
+    EXPECT_THROW(pool.release(Qubit{0}), RuntimeError);
+    Qubit q = pool.allocate();
+    pool.release(q);
+    EXPECT_THROW(pool.release(q), RuntimeError);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace test
+}  // namespace qiree
@@ -31,6 +31,10 @@ TEST(ResultDistributionTest, AccumulateAndCount)
 
     EXPECT_EQ(dist.count("101"), 2u);
     EXPECT_EQ(dist.count("011"), 1u);
+
+    // Accumulate several sampled shots at once
+    dist.accumulate(r3, 5);
+    EXPECT_EQ(dist.count("011"), 6u);
 }
 
 // Test that accumulating a RecordedResult with different bit-length throws.
@@ -147,6 +151,41 @@ TEST(ResultDistributionTest, EncodeBitStringInvalidInputs)
     EXPECT_THROW(encode_bit_string(too_many_bits, result), RuntimeError);
 }
 
+// Test merging distributions
+TEST(ResultDistributionTest, AccumulateDistribution)
+{
+    ResultDistribution a;
+    ResultDistribution b;
+    RecordedResult r00({false, false});
+    RecordedResult r01({false, true});
+    RecordedResult r11({true, true});
+    a.accumulate(r00);
+    a.accumulate(r01);
+    b.accumulate(r01);
+    b.accumulate(r11);
+    b.accumulate(r11);
+
+    a.accumulate(b);
+    EXPECT_EQ(a.size(), 3);
+    EXPECT_EQ(a.count("00"), 1);
+    EXPECT_EQ(a.count("01"), 2);
+    EXPECT_EQ(a.count("11"), 2);
+
+    // Merging an empty distribution has no effect
+    a.accumulate(ResultDistribution{});
+    EXPECT_EQ(a.size(), 3);
+
+    // Merging into an empty distribution copies
+    ResultDistribution c;
+    c.accumulate(b);
+    EXPECT_EQ(c.count("11"), 2);
+
+    // Key lengths must match
+    ResultDistribution d;
+    d.accumulate(RecordedResult({true, false, true}));
+    EXPECT_THROW(a.accumulate(d), RuntimeError);
+}
+
 //---------------------------------------------------------------------------//
 }  // namespace test
 }  // namespace qiree
@@ -0,0 +1,155 @@
+//----------------------------------*-C++-*----------------------------------//
+// Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//---------------------------------------------------------------------------//
+//! \file qiree/ShotScheduler.test.cc
+//---------------------------------------------------------------------------//
+#include "qiree/ShotScheduler.hh"
+
+#include <memory>
+#include <vector>
+
+#include "QuantumTestImpl.hh"
+#include "qiree/Executor.hh"
+#include "qiree/Module.hh"
+#include "qiree/ResultDistribution.hh"
+#include "qiree/SingleResultRuntime.hh"
+#include "qiree_test.hh"
+
+namespace qiree
+{
+namespace test
+{
+//---------------------------------------------------------------------------//
+//! Record results from the test quantum interface
+class SingleResultTestImpl final : public SingleResultRuntime
+{
+  public:
+    explicit SingleResultTestImpl(QuantumInterface const& sim)
+        : SingleResultRuntime{sim}
+    {
+    }
+
+    void initialize(OptionalCString) final {}
+};
+
+//---------------------------------------------------------------------------//
+class ShotSchedulerTest : public ::qiree::test::Test
+{
+  protected:
+    //! Create a scheduler for the bell circuit
+    std::unique_ptr<ShotScheduler> make_scheduler(ShotSchedulerOptions opts)
+    {
+        execute_ = std::make_unique<Executor>(
+            Module(this->test_data_path("bell.ll")));
+        auto make_backend = [this](size_type, size_type) {
+            results_.push_back(std::make_unique<TestResult>());
+            auto sim = std::make_shared<QuantumTestImpl>(
+                results_.back().get());
+            auto rt = std::make_shared<SingleResultTestImpl>(*sim);
+            return ShotScheduler::Backend{std::move(sim), std::move(rt)};
+        };
+        return std::make_unique<ShotScheduler>(*execute_, make_backend, opts);
+    }
+
+    std::unique_ptr<Executor> execute_;
+    std::vector<std::unique_ptr<TestResult>> results_;
+};
+
+//---------------------------------------------------------------------------//
+TEST_F(ShotSchedulerTest, worker_seed)
+{
+    EXPECT_EQ(0, ShotScheduler::worker_seed(0, 1));
+    EXPECT_EQ(0, ShotScheduler::worker_seed(0, 4));
+    EXPECT_EQ(1073741823ul, ShotScheduler::worker_seed(1, 4));
+    EXPECT_EQ(3221225469ul, ShotScheduler::worker_seed(3, 4));
+}
+
+TEST_F(ShotSchedulerTest, serial)
+{
+    auto schedule = this->make_scheduler({});
+    EXPECT_EQ(1, schedule->num_workers());
+
+    ResultDistribution dist = (*schedule)(25);
+    EXPECT_EQ(1, dist.size());
+    EXPECT_EQ(25, dist.count("00"));
+
+    auto const& stats = schedule->stats();
+    EXPECT_EQ(25, stats.num_shots);
+    EXPECT_EQ(1, stats.num_workers);
+    EXPECT_EQ(0, stats.num_steals);
+    EXPECT_EQ(24, stats.num_replayed);
+}
+
+TEST_F(ShotSchedulerTest, no_replay)
+{
+    ShotSchedulerOptions opts;
+    opts.replay = false;
+    auto schedule = this->make_scheduler(opts);
+    ResultDistribution dist = (*schedule)(10);
+    EXPECT_EQ(10, dist.count("00"));
+    EXPECT_EQ(0, schedule->stats().num_replayed);
+
+    // Replayed shots make exactly the same calls as executed ones
+    auto replay_schedule = this->make_scheduler({});
+    (*replay_schedule)(10);
+    EXPECT_EQ(9, replay_schedule->stats().num_replayed);
+    ASSERT_EQ(2, results_.size());
+    EXPECT_EQ(results_[0]->commands.str(), results_[1]->commands.str());
+}
+
+TEST_F(ShotSchedulerTest, compact_qubits)
+{
+    ShotSchedulerOptions opts;
+    opts.compact_qubits = true;
+    opts.prune_lightcone = true;
+    auto schedule = this->make_scheduler(opts);
+    ResultDistribution dist = (*schedule)(10);
+    EXPECT_EQ(10, dist.count("00"));
+    EXPECT_EQ(9, schedule->stats().num_replayed);
+    EXPECT_EQ(2, schedule->stats().replay_qubits);
+    EXPECT_EQ(0, schedule->stats().gates_pruned);
+
+    // Without compaction the replay width is not reported
+    auto plain = this->make_scheduler({});
+    (*plain)(10);
+    EXPECT_EQ(0, plain->stats().replay_qubits);
+    ASSERT_EQ(2, results_.size());
+    EXPECT_EQ(results_[0]->commands.str(), results_[1]->commands.str());
+}
+
+TEST_F(ShotSchedulerTest, parallel)
+{
+    ShotSchedulerOptions opts;
+    opts.num_workers = 4;
+    opts.chunk_size = 3;
+    auto schedule = this->make_scheduler(opts);
+    EXPECT_EQ(4, schedule->num_workers());
+    EXPECT_EQ(4, results_.size());
+
+    for (size_type num_shots : {1000, 7, 2})
+    {
+        ResultDistribution dist = (*schedule)(num_shots);
+        EXPECT_EQ(num_shots, dist.count("00"));
+        EXPECT_EQ(num_shots, schedule->stats().num_shots);
+        EXPECT_LE(schedule->stats().num_workers, num_shots);
+    }
+
+    // Each shot ran exactly once, on whichever worker took its chunk
+    size_type num_h{0};
+    for (auto const& tr : results_)
+    {
+        std::string const cmds = tr->commands.str();
+        for (auto pos = cmds.find("h("); pos != std::string::npos;
+             pos = cmds.find("h(", pos + 1))
+        {
+            ++num_h;
+        }
+    }
+    EXPECT_EQ(1000 + 7 + 2, num_h);
+}
+
+//---------------------------------------------------------------------------//
+}  // namespace test
+}  // namespace qiree
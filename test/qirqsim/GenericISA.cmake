@@ -0,0 +1,40 @@
+#---------------------------------*-CMake-*----------------------------------#
+# Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+# See the top-level COPYRIGHT file for details.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#----------------------------------------------------------------------------#
+# Check that a library contains no VEX- or EVEX-encoded instructions.
+#
+# The generic qsim library runs on any x86 CPU, so code compiled for a SIMD
+# kernel (e.g. an inline function merged from a kernel's translation unit)
+# must not end up in it. Run as a script:
+#
+#   cmake -DOBJDUMP=<objdump> -DLIBRARY=<library> -P GenericISA.cmake
+#----------------------------------------------------------------------------#
+
+execute_process(
+  COMMAND "${OBJDUMP}" --disassemble --no-show-raw-insn --demangle
+    "${LIBRARY}"
+  OUTPUT_VARIABLE _disassembly
+  ERROR_VARIABLE _error
+  RESULT_VARIABLE _result
+)
+if(NOT _result EQUAL 0)
+  message(FATAL_ERROR "Failed to disassemble ${LIBRARY}: ${_error}")
+endif()
+
+# AVX instructions are spelled with a "v" prefix, and AVX-512 adds the mask
+# registers %k0-%k7
+string(REGEX MATCHALL "\n[^\n]*\t(v[a-z0-9]+( [^\n]*)?|[^\n]*%k[0-7][^\n]*)"
+  _matches "${_disassembly}"
+)
+list(LENGTH _matches _num_matches)
+if(_num_matches GREATER 0)
+  list(SUBLIST _matches 0 10 _matches)
+  string(REPLACE ";" "" _matches "${_matches}")
+  message(FATAL_ERROR
+    "${LIBRARY} contains ${_num_matches} vector extension instructions:"
+    "${_matches}"
+  )
+endif()
+message(STATUS "No vector extension instructions in ${LIBRARY}")
@@ -0,0 +1,119 @@
+#---------------------------------*-CMake-*----------------------------------#
+# Copyright 2025 UT-Battelle, LLC, and other QIR-EE developers.
+# See the top-level COPYRIGHT file for details.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#----------------------------------------------------------------------------#
+# Check that a SIMD kernel library runs no vector instructions when loaded.
+#
+# The kernel libraries are linked into the generic qsim library, so the
+# dynamic loader runs their initializers (and, at exit, finalizers) on every
+# CPU. Starting from _init and the entries of .init_array and .fini_array,
+# follow direct calls and jumps within the library and fail if any reached
+# function contains VEX- or EVEX-encoded instructions. Only 64-bit
+# little-endian libraries are supported. Run as a script:
+#
+#   cmake -DOBJDUMP=<objdump> -DLIBRARY=<library> -P InitISA.cmake
+#----------------------------------------------------------------------------#
+cmake_minimum_required(VERSION 3.18)
+
+execute_process(
+  COMMAND "${OBJDUMP}" --disassemble --no-show-raw-insn "${LIBRARY}"
+  OUTPUT_VARIABLE _disassembly
+  ERROR_VARIABLE _error
+  RESULT_VARIABLE _result
+)
+if(NOT _result EQUAL 0)
+  message(FATAL_ERROR "Failed to disassemble ${LIBRARY}: ${_error}")
+endif()
+
+# Index function bodies by name and address; objdump separates them with a
+# blank line
+string(REPLACE ";" "," _disassembly "${_disassembly}")
+string(REPLACE "\n\n" ";" _blocks "${_disassembly}")
+foreach(_block IN LISTS _blocks)
+  if(_block MATCHES "^([0-9a-f]+) <([^>]+)>:\n")
+    set(_name "${CMAKE_MATCH_2}")
+    string(REGEX REPLACE "^0+" "" _addr "${CMAKE_MATCH_1}")
+    set("_body_${_name}" "${_block}")
+    set("_name_${_addr}" "${_name}")
+  endif()
+endforeach()
+
+# Read the function pointers in the initializer and finalizer arrays
+set(_pending "_init")
+foreach(_section .init_array .fini_array)
+  execute_process(
+    COMMAND "${OBJDUMP}" --full-contents --section=${_section} "${LIBRARY}"
+    OUTPUT_VARIABLE _contents
+    ERROR_QUIET
+  )
+  string(REGEX MATCHALL "\n *[0-9a-f]+( [0-9a-f]+)+" _lines "${_contents}")
+  set(_bytes "")
+  foreach(_line IN LISTS _lines)
+    string(REGEX REPLACE "^\n *[0-9a-f]+ " "" _line "${_line}")
+    string(REPLACE " " "" _line "${_line}")
+    string(APPEND _bytes "${_line}")
+  endforeach()
+  string(LENGTH "${_bytes}" _len)
+  set(_pos 0)
+  while(_pos LESS _len)
+    set(_addr "")
+    foreach(_byte RANGE 7)
+      math(EXPR _offset "${_pos} + 2 * ${_byte}")
+      string(SUBSTRING "${_bytes}" ${_offset} 2 _hex)
+      string(PREPEND _addr "${_hex}")
+    endforeach()
+    string(REGEX REPLACE "^0+" "" _addr "${_addr}")
+    if(NOT DEFINED "_name_${_addr}")
+      message(FATAL_ERROR
+        "${_section} entry 0x${_addr} in ${LIBRARY} is not a function"
+      )
+    endif()
+    list(APPEND _pending "${_name_${_addr}}")
+    math(EXPR _pos "${_pos} + 16")
+  endwhile()
+endforeach()
+
+# Visit every function reachable from the entry points
+set(_visited "")
+set(_failures "")
+list(LENGTH _pending _num_pending)
+while(_num_pending GREATER 0)
+  list(POP_FRONT _pending _name)
+  list(LENGTH _pending _num_pending)
+  if(_name IN_LIST _visited OR NOT DEFINED "_body_${_name}")
+    continue()
+  endif()
+  list(APPEND _visited "${_name}")
+  set(_body "${_body_${_name}}")
+
+  # AVX instructions are spelled with a "v" prefix, and AVX-512 adds the mask
+  # registers %k0-%k7
+  if(_body MATCHES "\n[^\n]*\t(v[a-z0-9]+( [^\n]*)?|[^\n]*%k[0-7][^\n]*)")
+    string(APPEND _failures "\n  ${_name}:${CMAKE_MATCH_0}")
+  endif()
+
+  # Follow direct branches to code in this library
+  string(REGEX MATCHALL "\t(call|j[a-z]+) +[0-9a-f]+ <[^>@]+>" _branches
+    "${_body}"
+  )
+  foreach(_branch IN LISTS _branches)
+    string(REGEX REPLACE ".*<([^>+]+)(\\+0x[0-9a-f]+)?>$" "\\1" _target
+      "${_branch}"
+    )
+    list(APPEND _pending "${_target}")
+  endforeach()
+  list(LENGTH _pending _num_pending)
+endwhile()
+
+list(LENGTH _visited _num_visited)
+if(_failures)
+  message(FATAL_ERROR
+    "Load-time code in ${LIBRARY} uses vector extension instructions:"
+    "${_failures}"
+  )
+endif()
+message(STATUS
+  "No vector extension instructions in ${_num_visited} load-time functions "
+  "of ${LIBRARY}"
+)
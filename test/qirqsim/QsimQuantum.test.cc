@@ -7,16 +7,135 @@
 //---------------------------------------------------------------------------//
 #include "qirqsim/QsimQuantum.hh"
 
+#include <algorithm>
 #include <regex>
 
+#include "qiree/Executor.hh"
+#include "qiree/GateTape.hh"
+#include "qiree/Module.hh"
+#include "qiree/ResultDistribution.hh"
 #include "qiree/Types.hh"
 #include "qiree_test.hh"
+#include "qirqsim/QsimKernel.hh"
 #include "qirqsim/QsimRuntime.hh"
 
+// Qsim
+#include <qsim/lib/circuit.h>
+#include <qsim/lib/formux.h>
+#include <qsim/lib/fuser_mqubit.h>
+#include <qsim/lib/gates_qsim.h>
+#include <qsim/lib/io.h>
+#include <qsim/lib/run_qsim.h>
+#include <qsim/lib/simulator_basic.h>
+//
+
 namespace qiree
 {
 namespace test
 {
+//---------------------------------------------------------------------------//
+/*!
+ * Simulate with qsim's own runner, as QsimQuantum originally did.
+ *
+ * The pending circuit and a measurement gate are run through \c QSimRunner
+ * for each measurement, with the seed incremented each time. This is the
+ * reference for the incremental simulation with the basic kernel.
+ */
+struct RunnerReference
+{
+    using Gate = qsim::GateQSim<float>;
+
+    struct Factory
+    {
+        using Simulator = qsim::SimulatorBasic<qsim::For, float>;
+        using StateSpace = Simulator::StateSpace;
+
+        StateSpace CreateStateSpace() const { return StateSpace(1); }
+        Simulator CreateSimulator() const { return Simulator(1); }
+    };
+
+    using StateSpace = Factory::StateSpace;
+    using Fuser = qsim::MultiQubitGateFuser<qsim::IO, Gate>;
+    using Runner = qsim::QSimRunner<qsim::IO, Fuser, Factory>;
+
+    Factory factory;
+    qsim::Circuit<Gate> circuit;
+    StateSpace::State state;
+    unsigned long int seed;
+    unsigned int time{0};
+
+    RunnerReference(unsigned int num_qubits, unsigned long int s)
+        : state{factory.CreateStateSpace().Create(num_qubits)}, seed{s}
+    {
+        factory.CreateStateSpace().SetStateZero(state);
+        circuit.num_qubits = num_qubits;
+    }
+
+    Runner::Parameter parameters()
+    {
+        Runner::Parameter param;
+        param.seed = static_cast<unsigned int>(seed++);
+        param.max_fused_size = 2;
+        param.verbosity = 0;
+        return param;
+    }
+
+    void add_gate(GateOp const& op)
+    {
+        auto q = [&op](int i) { return static_cast<unsigned int>(op.ids[i]); };
+        float const theta = static_cast<float>(op.params[0]);
+        switch (op.code)
+        {
+            case GateOpCode::cnot:
+                return circuit.gates.push_back(
+                    qsim::GateCNot<float>::Create(time++, q(0), q(1)));
+            case GateOpCode::h:
+                return circuit.gates.push_back(
+                    qsim::GateHd<float>::Create(time++, q(0)));
+            case GateOpCode::rx:
+                return circuit.gates.push_back(
+                    qsim::GateRX<float>::Create(time++, q(0), theta));
+            case GateOpCode::ry:
+                return circuit.gates.push_back(
+                    qsim::GateRY<float>::Create(time++, q(0), theta));
+            case GateOpCode::rz:
+                return circuit.gates.push_back(
+                    qsim::GateRZ<float>::Create(time++, q(0), theta));
+            case GateOpCode::t:
+                return circuit.gates.push_back(
+                    qsim::GateT<float>::Create(time++, q(0)));
+            default:
+                FAIL() << "unsupported gate " << to_cstring(op.code);
+        }
+    }
+
+    // Run the pending circuit with a measurement of one qubit
+    QState measure(unsigned int qubit)
+    {
+        circuit.gates.push_back(
+            qsim::gate::Measurement<Gate>::Create(time++, {qubit}));
+        std::vector<StateSpace::MeasurementResult> results;
+        EXPECT_TRUE(
+            Runner::Run(this->parameters(), factory, circuit, state, results));
+        circuit.gates.clear();
+        EXPECT_EQ(1, results.size());
+        if (results.empty() || results[0].bitstring.size() != 1)
+        {
+            return QState::zero;
+        }
+        return static_cast<QState>(results[0].bitstring[0] != 0);
+    }
+
+    // Run the pending circuit and sample the final state
+    std::vector<std::uint64_t> sample(size_type num_shots)
+    {
+        auto param = this->parameters();
+        EXPECT_TRUE(Runner::Run(param, factory, circuit, state));
+        circuit.gates.clear();
+        return factory.CreateStateSpace().Sample(state, num_shots, param.seed);
+    }
+};
+
 //---------------------------------------------------------------------------//
 
 class QsimQuantumTest : public ::qiree::test::Test
@@ -141,6 +260,261 @@ TEST_F(QsimQuantumTest, result_order)
 
     qis.tear_down();
 }
+
+TEST_F(QsimQuantumTest, mid_circuit)
+{
+    using Q = Qubit;
+    using R = Result;
+
+    EntryPointAttrs attrs;
+    attrs.required_num_qubits = 3;
+    attrs.required_num_results = 3;
+
+    // Gates after a mid-circuit measurement act on the collapsed state
+    auto make_op = [](GateOpCode code, size_type a, size_type b = 0) {
+        GateOp op;
+        op.code = code;
+        op.ids = {a, b};
+        return op;
+    };
+    std::vector<GateOp> const ops{
+        make_op(GateOpCode::h, 0),
+        make_op(GateOpCode::cnot, 0, 1),
+        make_op(GateOpCode::mz, 0, 0),
+        make_op(GateOpCode::cnot, 0, 2),
+        make_op(GateOpCode::x, 1),
+        make_op(GateOpCode::mz, 1, 1),
+        make_op(GateOpCode::mz, 2, 2),
+    };
+
+    std::ostringstream os;
+    std::vector<int> counts(2, 0);
+    for (unsigned long int seed = 0; seed < 32; ++seed)
+    {
+        QsimQuantum qis{os, seed, 1};
+        qis.set_up(attrs);
+        qis.h(Q{0});
+        qis.cnot(Q{0}, Q{1});
+        qis.mz(Q{0}, R{0});
+        qis.cnot(Q{0}, Q{2});
+        qis.x(Q{1});
+        qis.mz(Q{1}, R{1});
+        qis.mz(Q{2}, R{2});
+        std::vector<QState> actual;
+        for (size_type r = 0; r < 3; ++r)
+        {
+            actual.push_back(qis.read_result(R{r}));
+        }
+        qis.tear_down();
+
+        QState const first = actual[0];
+        ++counts[static_cast<int>(first)];
+        EXPECT_EQ(first == QState::one ? QState::zero : QState::one,
+                  actual[1]);
+        EXPECT_EQ(first, actual[2]);
+
+        // Outcomes only depend on the seed, not on how gates are batched
+        QsimQuantum batched{os, seed, 1};
+        batched.set_up(attrs);
+        batched.apply(Span<GateOp const>{ops});
+        for (size_type r = 0; r < 3; ++r)
+        {
+            EXPECT_EQ(actual[r], batched.read_result(R{r})) << "seed " << seed;
+        }
+        batched.tear_down();
+
+        // The state is zeroed for the next execution
+        qis.set_up(attrs);
+        qis.x(Q{2});
+        qis.mz(Q{0}, R{0});
+        qis.mz(Q{2}, R{2});
+        EXPECT_EQ(QState::zero, qis.read_result(R{0}));
+        EXPECT_EQ(QState::one, qis.read_result(R{2}));
+        qis.tear_down();
+    }
+    EXPECT_GT(counts[0], 0);
+    EXPECT_GT(counts[1], 0);
+}
+
+TEST_F(QsimQuantumTest, matches_runner)
+{
+    EntryPointAttrs attrs;
+    attrs.required_num_qubits = 3;
+    attrs.required_num_results = 4;
+
+    auto make_op = [](GateOpCode code,
+                      size_type a,
+                      size_type b = 0,
+                      double theta = 0) {
+        GateOp op;
+        op.code = code;
+        op.ids = {a, b};
+        op.params = {theta};
+        return op;
+    };
+    std::vector<GateOp> const ops{
+        make_op(GateOpCode::h, 0),
+        make_op(GateOpCode::rx, 1, 0, 0.7),
+        make_op(GateOpCode::cnot, 0, 2),
+        make_op(GateOpCode::mz, 0, 0),
+        make_op(GateOpCode::ry, 0, 0, 1.3),
+        make_op(GateOpCode::cnot, 1, 0),
+        make_op(GateOpCode::rz, 2, 0, 0.4),
+        make_op(GateOpCode::h, 2),
+        make_op(GateOpCode::mz, 1, 1),
+        make_op(GateOpCode::t, 2),
+        make_op(GateOpCode::h, 2),
+        make_op(GateOpCode::cnot, 2, 0),
+        make_op(GateOpCode::mz, 0, 2),
+        make_op(GateOpCode::mz, 2, 3),
+    };
+
+    // Mid-circuit measurements give the runner's outcomes for each seed
+    std::ostringstream os;
+    size_type num_ones{0};
+    for (unsigned long int seed = 0; seed < 32; ++seed)
+    {
+        RunnerReference ref(attrs.required_num_qubits, seed);
+        std::vector<QState> expected(attrs.required_num_results);
+        for (GateOp const& op : ops)
+        {
+            if (op.code == GateOpCode::mz)
+            {
+                expected[op.ids[1]]
+                    = ref.measure(static_cast<unsigned int>(op.ids[0]));
+            }
+            else
+            {
+                ref.add_gate(op);
+            }
+        }
+
+        QsimQuantum qis{os, seed, 1, QsimKernel::basic};
+        qis.set_up(attrs);
+        qis.apply(Span<GateOp const>{ops});
+        for (size_type r = 0; r < attrs.required_num_results; ++r)
+        {
+            EXPECT_EQ(expected[r], qis.read_result(Result{r}))
+                << "seed " << seed << ", result " << r;
+            num_ones += static_cast<size_type>(expected[r]);
+        }
+        qis.tear_down();
+    }
+    EXPECT_GT(num_ones, 0);
+    EXPECT_LT(num_ones, 32 * attrs.required_num_results);
+
+    // Sampling draws the same basis states as qsim's state space
+    Executor execute{Module{this->test_data_path("bell.ll")}};
+    GateTape tape;
+    GateTape gates;
+    GateTape outputs;
+    {
+        QsimQuantum recorder{os, 0, 1};
+        QsimRuntime rt{os, recorder};
+        ASSERT_TRUE(recorder.record(execute, rt, &tape));
+    }
+    ASSERT_TRUE(split_terminal_measurements(tape, &gates, &outputs));
+
+    constexpr size_type num_shots{1000};
+    QsimQuantum qis{os, 5, 1, QsimKernel::basic};
+    QsimRuntime rt{os, qis};
+    ResultDistribution dist = qis.sample(
+        execute.entry_point_attrs(), gates, outputs, rt, num_shots);
+
+    RunnerReference ref(2, 5);
+    for (size_type i = 0; i < gates.size(); ++i)
+    {
+        ref.add_gate(gates[i]);
+    }
+    auto const samples = ref.sample(num_shots);
+    EXPECT_EQ(std::count(samples.begin(), samples.end(), 0b00),
+              dist.count("00"));
+    EXPECT_EQ(std::count(samples.begin(), samples.end(), 0b11),
+              dist.count("11"));
+}
+
+TEST_F(QsimQuantumTest, sample)
+{
+    Executor execute{Module{this->test_data_path("bell.ll")}};
+
+    std::ostringstream os;
+    QsimQuantum qis{os, 0, 1};
+    QsimRuntime rt{os, qis};
+
+    GateTape tape;
+    GateTape gates;
+    GateTape outputs;
+    ASSERT_TRUE(qis.record(execute, rt, &tape));
+    ASSERT_TRUE(split_terminal_measurements(tape, &gates, &outputs));
+    EXPECT_EQ(2, gates.size());
+
+    // Only correlated outcomes of the Bell pair are sampled
+    constexpr size_type num_shots{1000};
+    ResultDistribution dist = qis.sample(
+        execute.entry_point_attrs(), gates, outputs, rt, num_shots);
+    EXPECT_EQ(num_shots, dist.count("00") + dist.count("11"));
+    EXPECT_EQ(2, dist.size());
+    size_type total{0};
+    for (auto const& [key, count] : dist)
+    {
+        total += count;
+    }
+    EXPECT_EQ(num_shots, total);
+    EXPECT_GT(dist.count("00"), num_shots / 4);
+    EXPECT_GT(dist.count("11"), num_shots / 4);
+
+    // The simulator runs normally after sampling
+    qis.set_up(execute.entry_point_attrs());
+    qis.x(Qubit{1});
+    qis.mz(Qubit{1}, Result{1});
+    EXPECT_EQ(QState::one, qis.read_result(Result{1}));
+    qis.tear_down();
+}
+
+TEST_F(QsimQuantumTest, kernels)
+{
+    using Q = Qubit;
+    using R = Result;
+
+    EXPECT_EQ(QsimKernel::avx2, to_qsim_kernel("avx2"));
+    EXPECT_STREQ("auto", to_cstring(QsimKernel::automatic));
+    EXPECT_TRUE(is_available(QsimKernel::basic));
+    EXPECT_TRUE(is_available(best_qsim_kernel()));
+
+    // Every available kernel should give the same deterministic outcome
+    for (auto kernel : {QsimKernel::basic,
+                        QsimKernel::sse,
+                        QsimKernel::avx2,
+                        QsimKernel::avx512})
+    {
+        if (!is_available(kernel))
+        {
+            continue;
+        }
+        std::ostringstream os;
+        QsimQuantum qis{os, 0, 1, kernel};
+        EXPECT_EQ(kernel, qis.kernel());
+
+        qis.set_up([] {
+            EntryPointAttrs attrs;
+            attrs.required_num_qubits = 3;
+            attrs.required_num_results = 3;
+            return attrs;
+        }());
+        qis.x(Q{0});
+        qis.h(Q{1});
+        qis.cnot(Q{0}, Q{2});
+        qis.h(Q{1});
+        qis.mz(Q{0}, R{0});
+        qis.mz(Q{1}, R{1});
+        qis.mz(Q{2}, R{2});
+        EXPECT_EQ(QState::one, qis.read_result(R{0})) << to_cstring(kernel);
+        EXPECT_EQ(QState::zero, qis.read_result(R{1})) << to_cstring(kernel);
+        EXPECT_EQ(QState::one, qis.read_result(R{2})) << to_cstring(kernel);
+        qis.tear_down();
+    }
+}
+
 //---------------------------------------------------------------------------//
 }  // namespace test
 }  // namespace qiree